@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace ugfx {
 
     struct Vector2 {
@@ -34,12 +36,27 @@ namespace ugfx {
         int height = 0;
     };
 
+    // Layout matches SDL_Vertex so geometry can be handed to backends without repacking.
+    struct Vertex2D {
+        Vector2 position;
+        Color   color;
+        Vector2 texCoord;
+    };
+
     struct Font {
         int id = -1;  // universal ID for resource manager
     };
 
+    // Text rendered once by ITextRenderer::CreateTextObject
+    struct TextObject {
+        int       id     = -1;
+        Rectangle bounds = {};  // drawn area relative to the draw position
+    };
+
     enum class Flip { None, Horizontal, Vertical, Both };
 
+    enum class BlendMode { Alpha, Additive, Multiply, None };
+
     enum class Key {
         key_null = 0,  // Key: NULL, used for no key pressed
         // Alphanumeric keys
@@ -157,6 +174,35 @@ namespace ugfx {
         volume_down = 25   // Key: Android volume down button
     };
 
-    enum class BackendType { SDL, RAYLIB };
+    enum class MouseButton : uint8_t { Left, Right, Middle, Side, Extra };
+
+    // Gamepad layout by position (FaceDown is A on an Xbox pad, cross on a PlayStation one), in raylib's order
+    enum class GamepadButton : uint8_t {
+        Unknown = 0,
+        DpadUp,
+        DpadRight,
+        DpadDown,
+        DpadLeft,
+        FaceUp,
+        FaceRight,
+        FaceDown,
+        FaceLeft,
+        LeftShoulder,
+        LeftTrigger,
+        RightShoulder,
+        RightTrigger,
+        Back,
+        Guide,
+        Start,
+        LeftThumb,
+        RightThumb,
+        Count
+    };
+
+    // Sticks range from -1 to 1 (down and right positive), triggers from 0 to 1
+    enum class GamepadAxis : uint8_t { LeftX, LeftY, RightX, RightY, LeftTrigger, RightTrigger, Count };
+
+    enum class BackendType { SDL, Raylib };
 
+    enum class WindowActivity { Focused, Unfocused, Minimized };  // Minimized also covers hidden windows
 }  // namespace ugfx
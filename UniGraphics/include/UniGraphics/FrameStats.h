@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "CommonTypes.h"
+
+namespace ugfx {
+
+    inline double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Steady clock time in nanoseconds, the timebase of input event timestamps
+    inline uint64_t SteadyNanoseconds() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    // Milliseconds spent bringing a backend up, by phase. Subsystems initialized lazily add their cost on first use.
+    struct StartupStats {
+        std::chrono::steady_clock::time_point origin;  // backend construction
+
+        double backendInit    = 0.0;  // platform library init in the backend constructor
+        double windowCreate   = 0.0;
+        double rendererCreate = 0.0;
+        double imageInit      = 0.0;  // on the first texture load
+        double fontInit       = 0.0;  // on the first font load or default-font text
+        double gamepadInit    = 0.0;  // on the first gamepad query
+        double firstPresent   = 0.0;  // from origin to the end of the first presented frame
+    };
+
+    // Per-frame counters shared by the window, input and renderer of a backend.
+    // Counters are reset by IRenderer::BeginDrawing.
+    struct FrameStats {
+        uint64_t frameIndex = 0;
+
+        // Renderer state
+        uint32_t stateChanges       = 0;  // state calls forwarded to the backend
+        uint32_t stateChangesElided = 0;  // redundant state calls filtered by the state cache
+        uint32_t drawCalls          = 0;  // draw calls submitted to the renderer
+        uint32_t drawsSorted        = 0;  // draws replayed through the sorted draw queue
+        uint32_t drawsCulled        = 0;  // draws (and DrawSprites sprites) skipped as off-screen or clipped
+
+        // Rendered text cache behind DrawText
+        uint32_t textCacheHits   = 0;
+        uint32_t textCacheMisses = 0;
+        uint64_t textCacheBytes  = 0;  // current size, not reset per frame
+
+        // Timing of the last completed frame: BeginDrawing to the present call, and the present call itself
+        // (blocking on vsync or a frame limiter)
+        float cpuTimeMs     = 0.0f;
+        float presentWaitMs = 0.0f;
+        float renderScale   = 1.0f;  // dynamic resolution scale the frame was drawn at
+
+        // Input, set by the input when a frame's events are collected rather than reset per frame. The latency is
+        // from the oldest event of the last frame that had input to the end of that frame's present call.
+        uint32_t inputEvents        = 0;  // events delivered to the current frame
+        uint32_t inputEventsDropped = 0;  // events lost to a full event ring so far
+        uint32_t inputMotionMerged  = 0;  // mouse motion events coalesced into earlier ones so far
+        float    inputLatencyMs     = 0.0f;
+        uint64_t inputTimestamp     = 0;  // oldest event not yet presented, SteadyNanoseconds; 0 = none
+
+        // Late sampling, set the same way
+        float    pointerLatencyMs = 0.0f;  // from the last IInput::ResamplePointer to the end of its present
+        uint64_t pointerTimestamp = 0;     // when ResamplePointer last sampled, 0 = not this frame
+        float    latchDelayMs     = 0.0f;  // late latch wait before the frame's event pump
+
+        // Fixed-step loop, set by FixedStepLoop each frame it runs. Update is the frame's simulation ticks, on the
+        // worker when pipelined; render is BeginDrawing through EndDrawing, present wait included; wait is the time
+        // the pipelined loop blocked on the worker after rendering.
+        float    updateMs           = 0.0f;
+        float    renderMs           = 0.0f;
+        float    waitMs             = 0.0f;
+        uint32_t simTicks           = 0;     // ticks run this frame
+        uint32_t simTicksDropped    = 0;     // ticks skipped by the per-frame tick limit so far
+        float    interpolationAlpha = 0.0f;  // passed to the frame's render
+
+        // Window activity and the frame rate cap it selects, not reset per frame
+        WindowActivity activity        = WindowActivity::Focused;
+        int            targetFps       = 0;  // 0 = uncapped
+        uint32_t       activityChanges = 0;  // focus, minimize and visibility transitions so far
+
+        StartupStats startup;  // filled once, never reset
+
+        void ResetFrame() {
+            ++frameIndex;
+            stateChanges       = 0;
+            stateChangesElided = 0;
+            drawCalls          = 0;
+            drawsSorted        = 0;
+            drawsCulled        = 0;
+            textCacheHits      = 0;
+            textCacheMisses    = 0;
+        }
+    };
+
+}  // namespace ugfx
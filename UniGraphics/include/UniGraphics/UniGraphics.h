@@ -1,8 +1,19 @@
 #pragma once
 
 #include "CommonTypes.h"
+#include "FrameStats.h"
 #include "ResourceManager.h"
+#include "core/ActionMap.h"
+#include "core/EventBus.h"
+#include "core/FixedStepLoop.h"
+#include "core/GlyphAtlas.h"
 #include "core/GraphicsBackend.h"
+#include "core/InputRecording.h"
+#include "core/JobSystem.h"
+#include "core/ParticleSystem.h"
+#include "core/Renderer.h"
+#include "core/SpriteScene.h"
+#include "core/TileMap.h"
 #include "interfaces/IGraphicsBackend.h"
 #include "interfaces/IInput.h"
 #include "interfaces/IRenderer.h"
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <vector>
+
+#include "UniGraphics.h"
+
+namespace ugfx::raylib {
+
+    // Rasterizes glyphs for a GlyphAtlas from in-memory TTF/OTF data through raylib's stb_truetype loader.
+    class RaylibGlyphSource : public IGlyphSource {
+       public:
+        RaylibGlyphSource(std::vector<unsigned char> fontData, int baseSize)
+            : m_FontData(std::move(fontData)), m_BaseSize(baseSize) {}
+
+        int   BaseSize() const override { return m_BaseSize; }
+        float LineHeight() const override { return static_cast<float>(m_BaseSize); }
+        bool  Rasterize(uint32_t codepoint, GlyphBitmap& out) override;
+
+       private:
+        std::vector<unsigned char> m_FontData;
+        int                        m_BaseSize = 0;
+    };
+
+    // Metrics of a raster raylib font as DrawTextEx places it, including the glyph spacing the renderer passes.
+    // Does not own the font.
+    class RaylibFontMetrics : public IGlyphMetrics {
+       public:
+        static constexpr float kSpacing = 1.0f;  // extra advance per glyph at the base size
+
+        explicit RaylibFontMetrics(const ::Font& font) : m_Font(font) {}
+
+        int   BaseSize() const override { return m_Font.baseSize; }
+        float LineHeight() const override { return static_cast<float>(m_Font.baseSize); }
+        float Advance(uint32_t codepoint) override;
+
+       private:
+        ::Font m_Font;
+    };
+
+}  // namespace ugfx::raylib
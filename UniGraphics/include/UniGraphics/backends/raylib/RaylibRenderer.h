@@ -2,58 +2,120 @@
 
 #include <raylib.h>
 
+#include <memory>
+#include <vector>
+
+#include "RaylibGlyphSource.h"
 #include "UniGraphics.h"
+#include "core/TextCache.h"
 
 namespace ugfx::raylib {
 
-    class RaylibRenderer : public IRenderer {
+    class RaylibRenderer : public Renderer {
        public:
-        RaylibRenderer();
+        explicit RaylibRenderer(FrameStats* stats = nullptr);
         ~RaylibRenderer() override;
 
         // IRenderer
-        void BeginDrawing() override;
-        void EndDrawing() override;
-        void Clear(Color color) override;
-        void ReleaseAllResources() override;
+        void  ReleaseAllResources() override;
         void* GetHandle() const override;
 
-        // IShapeRenderer
-        void DrawPixel(Vector2 pos, Color color) override;
-        void DrawLine(Vector2 start, Vector2 end, float thickness, Color color) override;
-        void DrawRectangle(Rectangle rec, Color color) override;
-        void DrawRectangleLines(Rectangle rec, float thickness, Color color) override;
-        void DrawCircle(Vector2 center, float radius, Color color) override;
-        void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) override;
-
         // IImageRenderer
         Texture LoadTexture(const std::string& path) override;
         void    UnloadTexture(Texture tex) override;
-        void    DrawTexture(Texture tex, Vector2 pos, Color tint) override;
-        void    DrawTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) override;
-        void    DrawTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
-                                  Flip flip, Color tint = {255, 255, 255, 255}) override;
-        void    DrawTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
-                              Color tint) override;
 
         // ITextRenderer
         Font LoadFont(const std::string& path, int size) override;
+        Font LoadSdfFont(const std::string& path) override;
+        bool AddFallbackFont(Font font, const std::string& path) override;
         void UnloadFont(Font font) override;
-        void DrawText(Font font, const std::string& text, Vector2 pos, Color color) override;
-        void DrawText(const std::string& text, Vector2 pos, int fontSize, Color color) override;
+
+        TextObject CreateTextObject(Font font, const std::string& text, float fontSize, Color color) override;
+        void       DestroyTextObject(TextObject object) override;
+        void       SetTextCacheBudget(size_t bytes) override;
+
+       protected:
+        // Renderer
+        Rectangle      GetViewport() const override;
+        IGlyphMetrics* GetGlyphMetrics(Font font, float fontSize) override;
+
+        void BeginFrame() override;
+        void EndFrame() override;
+        void RenderClear(Color color) override;
+        void ApplyBlendMode(BlendMode mode) override;
+        void ApplyClipRect(const Rectangle* rect) override;
+        void RenderPixel(Vector2 pos, Color color) override;
+        void RenderLine(Vector2 start, Vector2 end, float thickness, Color color) override;
+        void RenderRectangle(Rectangle rec, Color color) override;
+        void RenderRectangleLines(Rectangle rec, float thickness, Color color) override;
+        void RenderCircle(Vector2 center, float radius, Color color) override;
+        void RenderTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) override;
+        void RenderTexture(Texture tex, Vector2 pos, Color tint) override;
+        void RenderTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) override;
+        void RenderTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
+                                 Flip flip, Color tint) override;
+        void RenderTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
+                             Color tint) override;
+        void RenderGeometry(Texture tex, std::span<const Vertex2D> vertices, std::span<const int> indices) override;
+        void RenderText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) override;
+        void RenderTextObject(TextObject object, Vector2 pos) override;
 
        private:
-        ResourceManager<::Font>      m_FontManager;
+        // The atlas is uploaded as a single-channel texture and thresholded per pixel by m_SdfShader.
+        struct SdfFont {
+            explicit SdfFont(std::unique_ptr<IGlyphSource> source) : atlas(std::move(source)) {}
+
+            GlyphAtlas  atlas;
+            ::Texture2D texture = {};
+            uint32_t    version = 0;
+        };
+
+        // Raster fonts and distance field fonts share one id space
+        struct FontEntry {
+            ::Font                             raster = {};
+            std::unique_ptr<SdfFont>           sdf;
+            std::unique_ptr<RaylibFontMetrics> metrics;  // raster fonts only
+        };
+
+        // Text laid out once for redraws: white quads relative to the draw position, tinted when drawn. Distance
+        // field quads are rescaled if the atlas has grown since.
+        struct TextEntry {
+            int                   font        = 0;  // 0 = raylib's default font, -1 = the embedded SDF default
+            float                 fontSize    = 0.0f;
+            bool                  sdf         = false;
+            int                   atlasHeight = 0;
+            Color                 tint        = {255, 255, 255, 255};
+            std::vector<Vertex2D> vertices;
+            Rectangle             bounds = {};
+        };
+
+        ResourceManager<FontEntry>   m_FontManager;
         ResourceManager<::Texture2D> m_TextureManager;
+        ResourceManager<TextEntry>   m_TextObjects;
+        TextCache<TextEntry>         m_TextCache;
+
+        BlendMode m_BlendMode   = BlendMode::Alpha;
+        bool      m_ClipEnabled = false;
+        Rectangle m_ClipRect    = {};
+
+        // Dynamic resolution: a screen-sized render texture drawn into through a scale on the modelview matrix,
+        // so the frame covers its top-left m_SceneScale part, which EndFrame upscales to the screen
+        ::RenderTexture2D m_SceneTarget = {};
+        float             m_SceneScale  = 1.0f;  // < 1 while the current frame draws into m_SceneTarget
+
+        ::Shader                           m_SdfShader = {};  // loaded on first use
+        std::unique_ptr<RaylibFontMetrics> m_DefaultMetrics;  // GetFontDefault() only exists once a window is open
+        std::unique_ptr<SdfFont>           m_DefaultSdf;      // embedded font, created on the first sized default text
+        std::vector<Vertex2D>              m_TextVertices;
+        std::vector<int>                   m_TextIndices;
 
-        ::Font defaultFont() { return GetFontDefault(); }
-        ::Font resolveFont(Font font) {
-            if (font.id == -1)
-                return defaultFont();
-            if (auto* f = m_FontManager.Get(font.id))
-                return *f;
-            return defaultFont();
-        }
+        SdfFont* DefaultSdfFont();
+        void     RenderSdfText(SdfFont& font, const std::string& text, Vector2 pos, float fontSize, Color color);
+        bool     BakeText(Font font, const std::string& text, float fontSize, TextEntry& out);
+        void     DrawTextEntry(TextEntry& entry, Vector2 pos, Color tint);
+        void     UploadAtlas(SdfFont& font);
+        bool     LoadSdfShader();
+        void     DestroyFont(FontEntry* font);
     };
 
 }  // namespace ugfx::raylib
\ No newline at end of file
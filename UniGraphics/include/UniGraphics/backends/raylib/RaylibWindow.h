@@ -2,13 +2,17 @@
 
 #include <raylib.h>
 
+#include <thread>
+
 #include "UniGraphics.h"
+#include "core/FrameRateGovernor.h"
+#include "core/RedrawTracker.h"
 
 namespace ugfx::raylib {
 
     class RaylibWindow : public IWindow {
        public:
-        RaylibWindow();
+        explicit RaylibWindow(IInput* input = nullptr, FrameStats* stats = nullptr);
         ~RaylibWindow() override;
 
         bool                Create(const std::string& title, int width, int height, WindowFlags flags) override;
@@ -18,9 +22,40 @@ namespace ugfx::raylib {
         void                PollEvents() override;
         void                Shutdown() override;
         void                SetTargetFPS(int fps) override;
+        void                SetVSync(VSyncMode mode) override;
         float               GetDeltaTime() const override;
         uint32_t            GetTicks() const override;
         void*               GetHandle() const override;
+
+        // raylib waits inside EndDrawing, so every frame renders. Requests from other threads only set a flag that
+        // the next PollEvents picks up: raylib cannot wake a wait that is already blocking, so such a request
+        // renders once the next event arrives.
+        void SetWaitEvents(bool enabled) override;
+        bool NeedsRedraw() const override { return true; }
+        void RequestRedraw(uint32_t delayMs = 0) override;
+        void BeginAnimation() override;
+        void EndAnimation() override { m_Redraw.EndAnimation(); }
+
+        void           SetFrameRatePolicy(const FrameRatePolicy& policy) override;
+        WindowActivity GetActivity() const override { return m_Governor.Activity(); }
+        void           RegisterActivityCallback(ActivityCallback callback) override;
+
+        // EndDrawing already waits out the frame cap before polling input, and polling again after a later wait
+        // would drop the key presses raylib queued in between
+        void SetLateLatch(bool enabled) override {}
+
+       private:
+        uint64_t Now() const { return static_cast<uint64_t>(GetTime() * 1000.0); }
+        void     UpdateActivity();
+        void     ApplyFrameRate();
+
+        IInput*         m_Input      = nullptr;
+        FrameStats*     m_Stats      = nullptr;
+        RedrawTracker   m_Redraw;
+        bool            m_WaitEvents = false;
+        std::thread::id m_MainThread;  // the only thread that may toggle raylib's event waiting
+
+        FrameRateGovernor m_Governor;
     };
 
 }  // namespace ugfx::raylib
\ No newline at end of file
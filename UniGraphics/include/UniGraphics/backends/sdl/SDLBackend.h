@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CommonTypes.h"
 #include "UniGraphics.h"
 
 namespace ugfx::sdl {
@@ -9,7 +10,7 @@ namespace ugfx::sdl {
         SDLBackend();
         ~SDLBackend() override;
 
-        BackendType GetBackendType() { return BackendType::SDL; }
+        BackendType GetBackendType() override { return BackendType::SDL; }
     };
 
 }  // namespace ugfx::sdl
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL2/SDL_ttf.h>
+
+#include "UniGraphics.h"
+
+namespace ugfx::sdl {
+
+    // Rasterizes glyphs for a GlyphAtlas through SDL_ttf. Takes ownership of a font opened at the base size.
+    class SDLGlyphSource : public IGlyphSource {
+       public:
+        explicit SDLGlyphSource(TTF_Font* font, int baseSize) : m_Font(font), m_BaseSize(baseSize) {}
+        ~SDLGlyphSource() override;
+
+        SDLGlyphSource(const SDLGlyphSource&)            = delete;
+        SDLGlyphSource& operator=(const SDLGlyphSource&) = delete;
+
+        int   BaseSize() const override { return m_BaseSize; }
+        float LineHeight() const override;
+        bool  Rasterize(uint32_t codepoint, GlyphBitmap& out) override;
+        float Kerning(uint32_t left, uint32_t right) override;
+
+       private:
+        TTF_Font* m_Font     = nullptr;
+        int       m_BaseSize = 0;
+    };
+
+    // Metrics of a raster TTF_Font opened at size, as SDL_ttf lays it out when drawing. Does not own the font.
+    class SDLFontMetrics : public IGlyphMetrics {
+       public:
+        SDLFontMetrics(TTF_Font* font, int size) : m_Font(font), m_Size(size) {}
+
+        int   BaseSize() const override { return m_Size; }
+        float LineHeight() const override;
+        float Advance(uint32_t codepoint) override;
+        float Kerning(uint32_t left, uint32_t right) override;
+
+       private:
+        TTF_Font* m_Font = nullptr;
+        int       m_Size = 0;
+    };
+
+}  // namespace ugfx::sdl
@@ -4,54 +4,166 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <chrono>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
+#include "SDLGlyphSource.h"
+#include "SDLStateCache.h"
 #include "UniGraphics.h"
+#include "core/TextCache.h"
 
 namespace ugfx::sdl {
 
-    class SDLRenderer : public IRenderer {
+    class SDLRenderer : public Renderer {
        public:
-        explicit SDLRenderer(SDL_Window* window);
+        explicit SDLRenderer(FrameStats* stats = nullptr);
         ~SDLRenderer() override;
 
+        // Creates the SDL_Renderer once the window exists; SDLWindow::Create calls this. Nothing draws or loads
+        // textures before.
+        bool Attach(SDL_Window* window);
+
+        // Usable before Attach, which then creates the renderer with SDL_RENDERER_PRESENTVSYNC. Adaptive turns the
+        // wait off while frames miss their refresh, on renderers where the swap interval is cheap to change (opengl,
+        // direct3d11); elsewhere it is plain vsync.
+        void SetVSync(VSyncMode mode);
+
         // IRenderer
-        void BeginDrawing() override;
-        void EndDrawing() override;
-        void Clear(Color color) override;
-        void ReleaseAllResources() override;
+        void  ReleaseAllResources() override;
         void* GetHandle() const override;
 
-        // IShapeRenderer
-        void DrawPixel(Vector2 pos, Color color) override;
-        void DrawLine(Vector2 start, Vector2 end, float thickness, Color color) override;
-        void DrawRectangle(Rectangle rec, Color color) override;
-        void DrawRectangleLines(Rectangle rec, float thickness, Color color) override;
-        void DrawCircle(Vector2 center, float radius, Color color) override;
-        void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) override;
-
         // IImageRenderer
         Texture LoadTexture(const std::string& path) override;
         void    UnloadTexture(Texture tex) override;
-        void    DrawTexture(Texture tex, Vector2 pos, Color tint) override;
-        void    DrawTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) override;
-        void    DrawTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
-                                  Flip flip, Color tint = {255, 255, 255, 255}) override;
-        void    DrawTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
-                              Color tint) override;
 
         // ITextRenderer
         Font LoadFont(const std::string& path, int size) override;
+        Font LoadSdfFont(const std::string& path) override;
+        bool AddFallbackFont(Font font, const std::string& path) override;
         void UnloadFont(Font font) override;
-        void DrawText(Font font, const std::string& text, Vector2 pos, Color color) override;
-        void DrawText(const std::string& text, Vector2 pos, int fontSize, Color color) override;
+
+        TextObject CreateTextObject(Font font, const std::string& text, float fontSize, Color color) override;
+        void       DestroyTextObject(TextObject object) override;
+        void       SetTextCacheBudget(size_t bytes) override;
+
+       protected:
+        // Renderer
+        Rectangle      GetViewport() const override;
+        IGlyphMetrics* GetGlyphMetrics(Font font, float fontSize) override;
+
+        void BeginFrame() override;
+        void EndFrame() override;
+        void RenderClear(Color color) override;
+        void ApplyBlendMode(BlendMode mode) override;
+        void ApplyClipRect(const Rectangle* rect) override;
+        void RenderPixel(Vector2 pos, Color color) override;
+        void RenderLine(Vector2 start, Vector2 end, float thickness, Color color) override;
+        void RenderRectangle(Rectangle rec, Color color) override;
+        void RenderRectangleLines(Rectangle rec, float thickness, Color color) override;
+        void RenderCircle(Vector2 center, float radius, Color color) override;
+        void RenderTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) override;
+        void RenderTexture(Texture tex, Vector2 pos, Color tint) override;
+        void RenderTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) override;
+        void RenderTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
+                                 Flip flip, Color tint) override;
+        void RenderTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
+                             Color tint) override;
+        void RenderGeometry(Texture tex, std::span<const Vertex2D> vertices, std::span<const int> indices) override;
+        void RenderText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) override;
+        void RenderTextObject(TextObject object, Vector2 pos) override;
 
        private:
+        // Without shaders the distance field is thresholded on the CPU: each size bucket (a quarter octave of
+        // scale) keeps its own alpha texture of the atlas, rebuilt only when the atlas gains glyphs.
+        struct SdfFont {
+            struct Bucket {
+                SDL_Texture* texture = nullptr;
+                uint32_t     version = 0;
+                int          height  = 0;
+            };
+
+            explicit SdfFont(std::unique_ptr<IGlyphSource> source) : atlas(std::move(source)) {}
+
+            GlyphAtlas                      atlas;
+            std::unordered_map<int, Bucket> buckets;
+        };
+
+        // Raster fonts draw at their loaded size, distance field fonts at any size; both share one id space.
+        struct FontEntry {
+            TTF_Font*                       raster = nullptr;
+            int                             size   = 0;
+            std::unique_ptr<SdfFont>        sdf;
+            std::unique_ptr<SDLFontMetrics> metrics;  // raster fonts only
+        };
+
+        // Text rendered once for redraws: a white texture tinted when drawn for raster fonts, or atlas quads
+        // relative to the draw position for distance field fonts, rescaled if the atlas has grown since.
+        struct TextEntry {
+            SDL_Texture*          texture     = nullptr;
+            Color                 tint        = {255, 255, 255, 255};
+            int                   font        = -1;
+            float                 fontSize    = 0.0f;
+            int                   atlasHeight = 0;
+            std::vector<Vertex2D> vertices;
+            Rectangle             bounds = {};
+        };
+
         SDL_Renderer* m_Renderer = nullptr;
-        TTF_Font*     m_DefaultFont = nullptr;
+        TTF_Font*     m_DefaultFont = nullptr;  // embedded font at kDefaultFontSize, opened on first use
 
         ResourceManager<SDL_Texture> m_TextureManager;
-        ResourceManager<TTF_Font>    m_FontManager;
+        ResourceManager<FontEntry>   m_FontManager;
+        ResourceManager<TextEntry>   m_TextObjects;
+        TextCache<TextEntry>         m_TextCache;
+
+        std::unique_ptr<SDLFontMetrics> m_DefaultMetrics;
+        std::unique_ptr<SdfFont>        m_DefaultSdf;  // embedded font, created on the first sized default text
+        std::vector<Vertex2D>    m_TextVertices;
+        std::vector<int>         m_TextIndices;
+        std::vector<uint32_t>    m_BucketPixels;
+
+        static constexpr int kAdaptiveStreak = 8;  // frames late or on time in a row before adaptive vsync switches
+
+        VSyncMode m_VSync             = VSyncMode::Off;
+        bool      m_PresentVSync      = false;            // what the SDL_Renderer currently does
+        bool      m_CheapSwapInterval = false;            // adaptive vsync is emulated only then
+        int       m_AdaptiveStreak    = 0;
+        float     m_RefreshMs         = 1000.0f / 60.0f;  // display refresh interval, queried on Attach
+
+        std::chrono::steady_clock::time_point m_LastPresent;
+
+        // Dynamic resolution: a window-sized target drawn into at RenderScale() through SDL's render scale, so
+        // the frame covers m_SceneRect and only that part is upscaled at present
+        SDL_Texture* m_SceneTarget = nullptr;
+        int          m_SceneWidth  = 0;
+        int          m_SceneHeight = 0;
+        SDL_Rect     m_SceneRect   = {0, 0, 0, 0};
+        bool         m_SceneActive = false;  // the current frame draws into m_SceneTarget
+        bool         m_SceneFailed = false;  // no render target support, stay at full resolution
+
+        SDLStateCache m_StateCache;
+        SDL_BlendMode m_BlendMode   = SDL_BLENDMODE_BLEND;
+        SDL_Rect      m_ClipRect    = {0, 0, 0, 0};
+        bool          m_ClipEnabled = false;
+
+        void SetPresentVSync(bool enabled);
+        void UpdateAdaptiveVSync();
+        bool BeginScaledFrame(float scale);
+        void ApplyDrawState(Color color);
+        void ApplyTextureState(SDL_Texture* texture, Color tint);
+
+        bool         BakeText(Font font, const std::string& text, float fontSize, Color color, TextEntry& out);
+        void         DrawTextEntry(TextEntry& entry, Vector2 pos, Color tint);
+        void         DrawSdfVertices(SdfFont& font, float fontSize);
+        void         ReleaseText(TextEntry& entry);
+        void         RenderSdfText(SdfFont& font, const std::string& text, Vector2 pos, float fontSize, Color color);
+        SDL_Texture* BucketTexture(SdfFont& font, float scale);
+        TTF_Font*    DefaultRasterFont();
+        SdfFont*     DefaultSdfFont();
+        void         DestroyBuckets(SdfFont& font);
+        void         DestroyFont(FontEntry* font);
     };
 
 }  // namespace ugfx::sdl
\ No newline at end of file
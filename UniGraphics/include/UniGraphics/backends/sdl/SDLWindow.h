@@ -2,14 +2,21 @@
 
 #include <SDL2/SDL.h>
 
+#include <atomic>
+
 #include "UniGraphics.h"
+#include "core/FrameRateGovernor.h"
+#include "core/LateLatch.h"
+#include "core/RedrawTracker.h"
 
 namespace ugfx::sdl {
 
+    class SDLRenderer;
+
+    // The SDL window is created by Create with its final size and flags, and the renderer attached to it then.
     class SDLWindow : public IWindow {
        public:
-        // SDLWindow();
-        explicit SDLWindow(IInput* input);
+        SDLWindow(IInput* input, SDLRenderer* renderer, FrameStats* stats);
         ~SDLWindow() override;
 
         bool                Create(const std::string& title, int width, int height, WindowFlags flags) override;
@@ -19,22 +26,55 @@ namespace ugfx::sdl {
         void                PollEvents() override;
         void                Shutdown() override;
         void                SetTargetFPS(int fps) override;
+        void                SetVSync(VSyncMode mode) override;
         float               GetDeltaTime() const override;
         uint32_t            GetTicks() const override;
         void*               GetHandle() const override;
 
+        void SetWaitEvents(bool enabled) override;
+        bool NeedsRedraw() const override { return m_NeedsRedraw; }
+        void RequestRedraw(uint32_t delayMs = 0) override;
+        void BeginAnimation() override { m_Redraw.BeginAnimation(); }
+        void EndAnimation() override { m_Redraw.EndAnimation(); }
+
+        void           SetFrameRatePolicy(const FrameRatePolicy& policy) override;
+        WindowActivity GetActivity() const override { return m_Governor.Activity(); }
+        void           RegisterActivityCallback(ActivityCallback callback) override;
+
+        void SetLateLatch(bool enabled) override;
+
         SDL_Window* GetWindow() const { return m_Window; }
 
        private:
+        bool HandleEvent(SDL_Event& event);  // false for the internal wake event
+        void UpdateActivity();
+        void ApplyFrameRate();
+        void LimitFrameRate();
+        void WaitForLatch();
+
         SDL_Window* m_Window          = nullptr;
         bool        m_ShouldClose     = false;
         Uint32      m_LastFrameTime   = 0;
-        float       m_TargetFrameTime = 0.0f;
+        float       m_TargetFrameTime = 0.0f;  // from the governor, 0 = uncapped
+
+        FrameRateGovernor m_Governor;
+        bool              m_ActivityDirty = false;  // a focus, minimize or visibility event arrived
+
+        RedrawTracker     m_Redraw;
+        std::atomic<bool> m_WaitEvents  = false;
+        std::atomic<bool> m_WakePending = false;  // a wake event is queued, don't push another
+        bool              m_NeedsRedraw = true;
+        Uint32            m_WakeEvent   = static_cast<Uint32>(-1);  // user event that ends a blocking wait
+
+        LateLatch m_Latch;
+        bool      m_LateLatch = false;
 
         int m_CachedWidth  = 0;
         int m_CachedHeight = 0;
 
-        IInput* m_Input = nullptr;
+        IInput*      m_Input    = nullptr;
+        SDLRenderer* m_Renderer = nullptr;
+        FrameStats*  m_Stats    = nullptr;
     };
 
 }  // namespace ugfx::sdl
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../CommonTypes.h"
+
+namespace ugfx {
+
+    struct DrawCommand {
+        enum class Type : uint8_t {
+            Pixel,
+            Line,
+            Rectangle,
+            RectangleLines,
+            Circle,
+            Triangle,
+            Texture,
+            TextureRegion,
+            TextureRegionPro,
+            TextureEx,
+            Geometry,
+            Text,
+            TextObject,
+        };
+
+        Type      type  = Type::Pixel;
+        Flip      flip  = Flip::None;
+        BlendMode blend = BlendMode::Alpha;
+        uint16_t  clip  = 0;  // 1-based index into DrawQueue::Clips(), 0 = no clip
+        Color     color = {255, 255, 255, 255};
+        Texture   texture;
+        Font      font;
+        int       textObject = -1;
+        Rectangle rect = {};  // rectangle, texture source region
+        Rectangle dest = {};
+        Vector2   p0 = {}, p1 = {}, p2 = {};  // points, positions, origin
+        float     value0 = 0.0f, value1 = 0.0f;  // thickness, radius, rotation, scale, font size
+
+        uint32_t dataOffset = 0, dataCount = 0;  // vertices or text characters in the queue arenas
+        uint32_t indexOffset = 0, indexCount = 0;
+    };
+
+    // Deferred draw list that reorders commands by (layer, texture/blend/clip state) while keeping painter's order
+    // for overlapping draws. Each command gets a "bucket": one more than the highest bucket of any earlier
+    // overlapping command with a different state in its layer, so a stable sort on (layer, bucket, state) can only
+    // move a command past draws it does not overlap or shares state with.
+    class DrawQueue {
+       public:
+        void Clear();
+        bool Empty() const { return m_Commands.empty(); }
+        size_t Size() const { return m_Commands.size(); }
+
+        // state identifies what breaks a batch (texture, font); blend and clip are folded in from the command.
+        DrawCommand& Push(const DrawCommand& cmd, int layer, uint32_t state, const Rectangle& bounds);
+
+        void     PushVertices(DrawCommand& cmd, std::span<const Vertex2D> vertices, std::span<const int> indices);
+        void     PushText(DrawCommand& cmd, std::string_view text);
+        uint16_t PushClip(const Rectangle& rect);
+
+        // Computes the replay order; stable radix sort over packed 64-bit keys.
+        void Sort();
+
+        std::span<const uint32_t> Order() const { return m_Order; }
+        const DrawCommand&        Command(uint32_t index) const { return m_Commands[index]; }
+        const Rectangle&          Clip(uint16_t clip) const { return m_Clips[clip - 1]; }
+
+        std::span<const Vertex2D> Vertices(const DrawCommand& cmd) const;
+        std::span<const int>      Indices(const DrawCommand& cmd) const;
+        std::string_view          Text(const DrawCommand& cmd) const;
+
+       private:
+        static constexpr int kCellShift = 6;  // 64px cells
+        static constexpr int kGridSize  = 1024;
+        static constexpr int kMaxCells  = 256;  // bigger draws are tracked layer-wide
+
+        struct Cell {
+            uint16_t level = 0;  // bucket + 1, 0 = empty
+            bool     mixed = false;
+            uint32_t state = 0;
+        };
+
+        struct LayerGrid {
+            Cell              floor;  // draws that cover (almost) everything
+            Cell              max;    // highest level seen anywhere in the layer
+            std::vector<Cell> cells;
+        };
+
+        static uint32_t Contribution(const Cell& cell, uint32_t state);
+        static void     Merge(Cell& cell, uint32_t level, uint32_t state);
+
+        LayerGrid& GridFor(int layer);
+
+        std::vector<DrawCommand> m_Commands;
+        std::vector<uint64_t>    m_Keys;
+        std::vector<uint32_t>    m_Order;
+        std::vector<uint32_t>    m_Scratch;
+        std::vector<uint64_t>    m_KeyScratch;
+
+        std::vector<Vertex2D>  m_Vertices;
+        std::vector<int>       m_Indices;
+        std::string            m_Text;
+        std::vector<Rectangle> m_Clips;
+
+        std::unordered_map<int, uint32_t> m_LayerIndex;
+        std::vector<LayerGrid>            m_Grids;
+        uint32_t                          m_GridsUsed = 0;
+        bool                              m_Overflow  = false;
+    };
+
+    // Stable LSD radix sort of indices by 64-bit key, skipping byte positions where all keys agree.
+    void RadixSortByKey(std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint64_t>& keyScratch,
+                        std::vector<uint32_t>& orderScratch);
+
+}  // namespace ugfx
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ugfx {
+
+    // The embedded Lexend TTF, decompressed on the first call and shared by every renderer until exit, so views
+    // over it (SDL_RWops, HarfBuzz blobs) never dangle. Empty if the embedded data is corrupt.
+    std::span<const uint8_t> DefaultFontData();
+
+    // Decodes one LZ4 block into exactly size bytes; false on malformed input or a size mismatch.
+    bool DecompressLz4(std::span<const uint8_t> src, size_t size, std::vector<uint8_t>& out);
+
+}  // namespace ugfx
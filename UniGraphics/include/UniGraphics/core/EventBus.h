@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "InputEvents.h"
+
+namespace ugfx {
+
+    // Listener callable stored inline: a function pointer plus up to kStorage bytes of trivially copyable state,
+    // enough for a lambda capturing a few pointers or references. Never allocates.
+    class EventListener {
+       public:
+        static constexpr size_t kStorage = 4 * sizeof(void*);
+
+        EventListener() = default;
+
+        template <typename F>
+            requires std::is_invocable_v<F&, const InputEvent&> && (!std::is_same_v<std::decay_t<F>, EventListener>)
+        EventListener(F fn) {
+            static_assert(sizeof(F) <= kStorage, "listener captures too much state, capture a pointer instead");
+            static_assert(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>,
+                          "listener state must be trivially copyable");
+            ::new (static_cast<void*>(m_Storage)) F(fn);
+            m_Invoke = [](void* storage, const InputEvent& event) { (*static_cast<F*>(storage))(event); };
+        }
+
+        explicit operator bool() const { return m_Invoke != nullptr; }
+
+        void operator()(const InputEvent& event) { m_Invoke(m_Storage, event); }
+
+       private:
+        alignas(std::max_align_t) unsigned char m_Storage[kStorage] = {};
+        void (*m_Invoke)(void*, const InputEvent&)                  = nullptr;
+    };
+
+    // Bit per InputEvent::Type, for subscribing to several kinds at once
+    using EventMask = uint32_t;
+
+    constexpr EventMask MaskOf(InputEvent::Type type) {
+        return EventMask(1) << static_cast<uint32_t>(type);
+    }
+
+    struct EventSubscription {
+        uint32_t id = 0;  // 0 = none
+    };
+
+    // Typed input event dispatch. Listeners subscribe to the event types they handle and live in one array per
+    // type, so an event only reaches the listeners of its own type. Listeners may subscribe and unsubscribe from
+    // inside a dispatch: removed ones stop receiving at once, added ones join once the current event is delivered.
+    // Main thread only.
+    class EventBus {
+       public:
+        static constexpr size_t kTypes = static_cast<size_t>(InputEvent::Type::Window) + 1;
+
+        EventSubscription Subscribe(InputEvent::Type type, EventListener listener) {
+            return Subscribe(MaskOf(type), listener);
+        }
+        EventSubscription Subscribe(EventMask types, EventListener listener);
+        void              Unsubscribe(EventSubscription& subscription);  // resets the handle
+        void              Clear();
+
+        void Dispatch(const InputEvent& event);
+        void Dispatch(std::span<const InputEvent> events) {
+            for (const InputEvent& event : events)
+                Dispatch(event);
+        }
+
+        size_t ListenerCount(InputEvent::Type type) const;
+
+       private:
+        struct Entry {
+            uint32_t      id;  // 0 once unsubscribed during a dispatch, removed afterwards
+            uint32_t      type;
+            EventListener listener;
+        };
+
+        void Compact();
+
+        std::array<std::vector<Entry>, kTypes> m_Listeners;
+        std::vector<Entry>                     m_Pending;  // subscribed during a dispatch
+        uint32_t                               m_NextId      = 1;
+        int                                    m_Dispatching = 0;
+        bool                                   m_Dirty       = false;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../CommonTypes.h"
+#include "TextLayout.h"
+
+namespace ugfx {
+
+    // One rasterized glyph as 8-bit coverage. Offsets place the bitmap relative to the pen with the pen at the top
+    // of the line.
+    struct GlyphBitmap {
+        std::vector<uint8_t> coverage;
+        int                  width   = 0;
+        int                  height  = 0;
+        int                  offsetX = 0;
+        int                  offsetY = 0;
+        float                advance = 0.0f;
+    };
+
+    // Output of a shaping engine, in pixels at the base size relative to the start of the run, y down.
+    struct ShapedGlyph {
+        uint32_t glyph   = 0;  // glyph index in the shaping font, 0 = not in the font
+        uint32_t cluster = 0;  // byte offset of the first code point it came from
+        float    x = 0.0f, y = 0.0f;
+        float    advance = 0.0f;
+    };
+
+    // Backend font rasterizer feeding a GlyphAtlas; glyphs are always produced at BaseSize().
+    class IGlyphSource {
+       public:
+        virtual ~IGlyphSource() = default;
+
+        virtual int   BaseSize() const   = 0;
+        virtual float LineHeight() const = 0;
+        // Returns false if the font has no glyph for the code point
+        virtual bool  Rasterize(uint32_t codepoint, GlyphBitmap& out) = 0;
+        virtual float Kerning(uint32_t left, uint32_t right) { return 0.0f; }
+
+        // Sources with a shaping engine lay out whole runs and address glyphs by index instead of code point
+        virtual bool CanShape() const { return false; }
+        virtual bool Shape(std::string_view text, std::vector<ShapedGlyph>& out) { return false; }
+        virtual bool RasterizeGlyph(uint32_t glyph, GlyphBitmap& out) { return false; }
+    };
+
+    // Signed distance field atlas for one font. Glyphs are rasterized once at the source's base size on first use,
+    // converted to distance fields and shelf-packed into a single 8-bit texture that serves every draw size.
+    // Backends upload Pixels() whenever Version() changes and threshold the field at 128 when drawing.
+    //
+    // Each distinct line of text is shaped once (by the primary source's shaping engine if it has one, otherwise
+    // by code point with kerning) and the glyph placement is cached, so repeated labels skip decoding and shaping.
+    class GlyphAtlas : public IGlyphMetrics {
+       public:
+        explicit GlyphAtlas(std::unique_ptr<IGlyphSource> source, int spread = 6, int width = 1024);
+
+        // Code points missing from the primary font are looked up in fallbacks, in the order added. Fallback glyphs
+        // share this atlas; fallbacks should use the primary's base size.
+        void AddFallback(std::unique_ptr<IGlyphSource> source);
+
+        // Appends one quad per visible glyph (four vertices, see BuildQuadIndices) with texture coordinates
+        // normalized to the current atlas size. Returns the number of quads added.
+        size_t BuildQuads(std::string_view text, Vector2 pos, float fontSize, Color color, std::vector<Vertex2D>& out);
+
+        float Scale(float fontSize) const { return fontSize / static_cast<float>(BaseSize()); }
+        int   Spread() const { return m_Spread; }
+
+        // IGlyphMetrics, from the same glyph table BuildQuads uses
+        int   BaseSize() const override { return m_Sources[0]->BaseSize(); }
+        float LineHeight() const override { return m_Sources[0]->LineHeight(); }
+        float Advance(uint32_t codepoint) override { return Find(codepoint).advance; }
+        float Kerning(uint32_t left, uint32_t right) override;
+        bool  ShapesRuns() const override { return m_Sources[0]->CanShape(); }
+        float MeasureRun(std::string_view run) override;
+
+        const std::vector<uint8_t>& Pixels() const { return m_Pixels; }
+        int                         Width() const { return m_Width; }
+        int                         Height() const { return m_Height; }
+        uint32_t                    Version() const { return m_Version; }  // bumped whenever Pixels() changes
+
+       private:
+        struct Glyph {
+            Rectangle region  = {};  // atlas pixels, padding included
+            float     offsetX = 0.0f, offsetY = 0.0f;
+            float     advance = 0.0f;
+            uint8_t   source  = 0;  // index into m_Sources
+            bool      loaded  = false;
+            bool      missing = false;  // no source had it; holds a copy of '?'
+        };
+
+        struct Placement {
+            const Glyph* glyph;
+            float        x, y;
+        };
+
+        struct Run {
+            std::string            text;
+            std::vector<Placement> glyphs;
+            float                  width    = 0.0f;  // pen advance at the base size
+            uint64_t               lastUsed = 0;
+        };
+
+        const Glyph&                  Find(uint32_t codepoint);
+        const Glyph&                  FindShaped(uint32_t glyphIndex);
+        const std::vector<Placement>& Shape(std::string_view line);
+        float                         ShapeLine(std::string_view line, std::vector<Placement>* glyphs);
+        void                          Store(uint8_t source, Glyph& glyph);
+        bool                          Allocate(int width, int height, int& x, int& y);
+
+        std::vector<std::unique_ptr<IGlyphSource>> m_Sources;
+
+        int                  m_Spread = 0;
+        int                  m_Width = 0, m_Height = 0;
+        int                  m_ShelfX = 0, m_ShelfY = 0, m_ShelfHeight = 0;
+        uint32_t             m_Version = 0;
+        std::vector<uint8_t> m_Pixels;
+
+        std::array<Glyph, 128>              m_Ascii;
+        std::unordered_map<uint32_t, Glyph> m_Glyphs;  // by code point, beyond ASCII
+        std::unordered_map<uint32_t, Glyph> m_Shaped;  // by primary source glyph index
+
+        std::unordered_map<uint64_t, Run> m_Runs;
+        uint64_t                          m_RunClock = 0;
+        std::vector<ShapedGlyph>          m_ShapeScratch;
+
+        GlyphBitmap          m_Bitmap;  // scratch, reused between glyphs
+        std::vector<uint8_t> m_Padded, m_Field;
+    };
+
+}  // namespace ugfx
@@ -17,10 +17,15 @@ namespace ugfx {
         IInput*    GetInput() override { return m_Input.get(); }
         IRenderer* GetRenderer() override { return m_Renderer.get(); }
 
+        const FrameStats& GetFrameStats() const override { return m_FrameStats; }
+        FrameStats&       GetFrameStats() override { return m_FrameStats; }
+
        protected:
         std::unique_ptr<IWindow>   m_Window;
         std::unique_ptr<IInput>    m_Input;
         std::unique_ptr<IRenderer> m_Renderer;
+
+        FrameStats m_FrameStats;
     };
 
 }  // namespace ugfx
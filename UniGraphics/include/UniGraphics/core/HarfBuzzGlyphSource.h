@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GlyphAtlas.h"
+
+namespace ugfx {
+
+    // True when the library was built with UGFX_USE_HARFBUZZ.
+    bool HarfBuzzAvailable();
+
+    // Glyph source that shapes whole runs with HarfBuzz (ligatures, combining marks, contextual forms) and
+    // rasterizes glyph outlines itself. Returns nullptr when HarfBuzz is unavailable or the data is not a font.
+    std::unique_ptr<IGlyphSource> CreateHarfBuzzGlyphSource(std::vector<uint8_t> fontData, int baseSize);
+
+}  // namespace ugfx
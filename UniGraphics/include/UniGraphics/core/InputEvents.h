@@ -0,0 +1,233 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../CommonTypes.h"
+#include "../FrameStats.h"
+
+namespace ugfx {
+
+    enum class WindowAction : uint8_t { Resized, FocusGained, FocusLost, Minimized, Restored, Shown, Hidden, Close };
+
+    // One input event in backend-neutral form. Only the fields of its type are meaningful.
+    struct InputEvent {
+        enum class Type : uint8_t { KeyDown, KeyUp, Text, MouseMove, MouseDown, MouseUp, Wheel, Window };
+
+        Type         type      = Type::KeyDown;
+        WindowAction window    = WindowAction::Resized;
+        MouseButton  button    = MouseButton::Left;
+        bool         repeat    = false;  // KeyDown from key repeat
+        Key          key       = Key::key_null;
+        uint32_t     codepoint = 0;     // Text, one event per code point
+        Vector2      position  = {};    // mouse position, new size for Resized
+        Vector2      delta     = {};    // mouse motion, wheel scroll
+        uint64_t     timestamp = 0;     // when the event happened, SteadyNanoseconds()
+    };
+
+    // Fixed-capacity single-producer single-consumer ring. Push and Pop never block or allocate; Push fails when
+    // the ring is full. Capacity must be a power of two.
+    template <typename T, size_t Capacity>
+    class SpscRing {
+        static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+       public:
+        bool Push(const T& value) {
+            const size_t head = m_Head.load(std::memory_order_relaxed);
+            if (head - m_Tail.load(std::memory_order_acquire) == Capacity)
+                return false;
+            m_Items[head & (Capacity - 1)] = value;
+            m_Head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Pop(T& out) {
+            const size_t tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail == m_Head.load(std::memory_order_acquire))
+                return false;
+            out = m_Items[tail & (Capacity - 1)];
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+       private:
+        std::array<T, Capacity> m_Items;
+        // Producer and consumer indices on separate cache lines
+        alignas(64) std::atomic<size_t> m_Head = 0;
+        alignas(64) std::atomic<size_t> m_Tail = 0;
+    };
+
+    inline constexpr size_t kKeyCount = 512;  // ugfx::Key values follow raylib's and stay below this
+
+    // Keyboard state indexed directly by ugfx::Key. Pressed and released hold until the next BeginFrame.
+    struct KeyboardState {
+        std::bitset<kKeyCount> down, pressed, released;
+
+        void BeginFrame() {
+            pressed.reset();
+            released.reset();
+        }
+
+        void Press(Key key) {
+            const auto k = static_cast<size_t>(key);
+            if (k == 0 || k >= kKeyCount || down.test(k))
+                return;
+            down.set(k);
+            pressed.set(k);
+        }
+
+        void Release(Key key) {
+            const auto k = static_cast<size_t>(key);
+            if (k == 0 || k >= kKeyCount)
+                return;
+            down.reset(k);
+            released.set(k);
+        }
+
+        static bool Test(const std::bitset<kKeyCount>& bits, Key key) {
+            const auto k = static_cast<size_t>(key);
+            return k < kKeyCount && bits.test(k);
+        }
+    };
+
+    // Mouse state rebuilt from input events. Motion and wheel accumulate until the next BeginFrame.
+    struct PointerState {
+        Vector2 position = {};
+        Vector2 delta    = {};
+        Vector2 wheel    = {};
+        uint8_t down     = 0;  // one bit per MouseButton
+        uint8_t pressed  = 0;
+        uint8_t released = 0;
+
+        void BeginFrame() {
+            delta    = {};
+            wheel    = {};
+            pressed  = 0;
+            released = 0;
+        }
+
+        void Apply(const InputEvent& e) {
+            const uint8_t bit = static_cast<uint8_t>(1u << static_cast<uint8_t>(e.button));
+            switch (e.type) {
+                case InputEvent::Type::MouseMove:
+                    position = e.position;
+                    delta.x += e.delta.x;
+                    delta.y += e.delta.y;
+                    break;
+                case InputEvent::Type::MouseDown:
+                    position = e.position;
+                    if (!(down & bit))
+                        pressed |= bit;
+                    down |= bit;
+                    break;
+                case InputEvent::Type::MouseUp:
+                    position = e.position;
+                    down &= ~bit;
+                    released |= bit;
+                    break;
+                case InputEvent::Type::Wheel:
+                    wheel.x += e.delta.x;
+                    wheel.y += e.delta.y;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        static bool Test(uint8_t bits, MouseButton button) { return bits & (1u << static_cast<uint8_t>(button)); }
+    };
+
+    // Input events between the backend that produces them and the frame that consumes them. The backend pushes
+    // as events arrive (from any one thread); Publish moves them into the frame's list, which stays readable
+    // without allocation until the next Publish.
+    //
+    // Runs of mouse motion are merged into one MouseMove with the last position and the summed delta unless
+    // coalescing is turned off, so a 1000 Hz mouse costs one event per frame instead of filling the ring. The
+    // merged event keeps the first motion's timestamp; the producer flushes the pending motion before Publish.
+    class InputEventQueue {
+       public:
+        static constexpr size_t kCapacity = 256;
+
+        void SetCoalesceMotion(bool enabled) {
+            FlushMotion();
+            m_CoalesceMotion = enabled;
+        }
+
+        bool Push(const InputEvent& event) {
+            if (event.type == InputEvent::Type::MouseMove && m_CoalesceMotion) {
+                if (m_HasMotion) {
+                    m_Motion.position = event.position;
+                    m_Motion.delta.x += event.delta.x;
+                    m_Motion.delta.y += event.delta.y;
+                    m_Coalesced.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    m_Motion    = event;
+                    m_HasMotion = true;
+                }
+                return true;
+            }
+            FlushMotion();  // keeps motion ordered before the clicks and keys that follow it
+            return PushRing(event);
+        }
+
+        void FlushMotion() {
+            if (m_HasMotion) {
+                m_HasMotion = false;
+                PushRing(m_Motion);
+            }
+        }
+
+        void Publish() {
+            m_Count = 0;
+            while (m_Count < kCapacity && m_Ring.Pop(m_Frame[m_Count]))
+                ++m_Count;
+        }
+
+        std::span<const InputEvent> Events() const { return {m_Frame.data(), m_Count}; }
+        uint32_t                    Dropped() const { return m_Dropped.load(std::memory_order_relaxed); }
+        uint32_t                    Coalesced() const { return m_Coalesced.load(std::memory_order_relaxed); }
+
+        // Oldest timestamp among the published events, 0 if there are none
+        uint64_t OldestTimestamp() const {
+            uint64_t oldest = 0;
+            for (size_t i = 0; i < m_Count; ++i)
+                if (oldest == 0 || m_Frame[i].timestamp < oldest)
+                    oldest = m_Frame[i].timestamp;
+            return oldest;
+        }
+
+        // Counts the frame's events in stats and starts the latency clock unless an earlier frame's is still
+        // waiting for its present
+        void Record(FrameStats& stats) const {
+            stats.inputEvents        = static_cast<uint32_t>(m_Count);
+            stats.inputEventsDropped = Dropped();
+            stats.inputMotionMerged  = Coalesced();
+            if (stats.inputTimestamp == 0)
+                stats.inputTimestamp = OldestTimestamp();
+        }
+
+       private:
+        bool PushRing(const InputEvent& event) {
+            if (m_Ring.Push(event))
+                return true;
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        SpscRing<InputEvent, kCapacity>   m_Ring;
+        std::array<InputEvent, kCapacity> m_Frame;
+        size_t                            m_Count     = 0;
+        std::atomic<uint32_t>             m_Dropped   = 0;
+        std::atomic<uint32_t>             m_Coalesced = 0;
+
+        // Producer side
+        InputEvent m_Motion;
+        bool       m_HasMotion      = false;
+        bool       m_CoalesceMotion = true;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../interfaces/IInput.h"
+#include "InputEvents.h"
+
+namespace ugfx {
+
+    // Input logs are a 5-byte header ("UGIR", version) followed by one record per frame: the frame's delta time
+    // in microseconds and its event count as varints, then the events. Each event is a packed type byte, its
+    // offset from the frame's first event in microseconds, and only the fields its type uses. Key state is not
+    // stored; it follows from the key events.
+
+    // Appends frames to an input log
+    class InputRecorder {
+       public:
+        ~InputRecorder() { Close(); }
+
+        bool Open(const std::string& path);  // false and logs if the file cannot be created
+        void Close();
+        bool IsOpen() const { return m_File.is_open(); }
+
+        void RecordFrame(float deltaTime, std::span<const InputEvent> events);
+
+        uint64_t Frames() const { return m_Frames; }
+
+       private:
+        std::ofstream        m_File;
+        std::vector<uint8_t> m_Buffer;
+        uint64_t             m_Frames = 0;
+    };
+
+    // Plays an input log back as an IInput, one logged frame per BeginFrame/EndFrame pair, with nothing read from
+    // the platform. Event timestamps are rebased onto the replay clock; DeltaTime is fixed unless set to 0, in which
+    // case the logged delta is used.
+    class ReplayInput : public IInput {
+       public:
+        bool Load(const std::string& path);  // false and logs on a missing or malformed log
+
+        void   SetFixedDelta(float seconds) { m_FixedDelta = seconds; }
+        float  DeltaTime() const;
+        bool   Finished() const { return m_Frame >= m_FrameStarts.size(); }
+        size_t FrameCount() const { return m_FrameStarts.size(); }
+
+        // IInput
+        void ProcessEvents(void*) override {}
+        void BeginFrame() override;
+        void EndFrame() override;
+
+        std::span<const InputEvent> GetEvents() const override { return m_Current; }
+        EventBus&                   GetEventBus() override { return m_Bus; }
+        void                        Snapshot(InputSnapshot& out) const override;
+
+        bool  IsKeyPressed(Key key) const override { return KeyboardState::Test(m_Keys.pressed, key); }
+        bool  IsKeyDown(Key key) const override { return KeyboardState::Test(m_Keys.down, key); }
+        bool  IsKeyReleased(Key key) const override { return KeyboardState::Test(m_Keys.released, key); }
+        bool  IsKeyUp(Key key) const override { return !KeyboardState::Test(m_Keys.down, key); }
+        void* GetHandle() const override { return nullptr; }
+
+        Vector2 GetMousePosition() const override { return m_Pointer.position; }
+        Vector2 GetMouseDelta() const override { return m_Pointer.delta; }
+        Vector2 GetMouseWheel() const override { return m_Pointer.wheel; }
+        bool    IsMouseButtonDown(MouseButton button) const override;
+        bool    IsMouseButtonPressed(MouseButton button) const override;
+        bool    IsMouseButtonReleased(MouseButton button) const override;
+        Vector2 ResamplePointer() override { return m_Pointer.position; }
+        void    SetRawMotion(bool) override {}  // motion plays back as it was recorded
+
+        // Gamepads are polled state rather than events and are not recorded
+        bool  IsGamepadAvailable(int) const override { return false; }
+        float GetGamepadAxis(int, GamepadAxis) const override { return 0.0f; }
+        bool  IsGamepadButtonDown(int, GamepadButton) const override { return false; }
+        bool  IsGamepadButtonPressed(int, GamepadButton) const override { return false; }
+        bool  IsGamepadButtonReleased(int, GamepadButton) const override { return false; }
+
+       private:
+        std::vector<InputEvent> m_Events;       // all frames, back to back, timestamps as logged offsets
+        std::vector<uint32_t>   m_FrameStarts;  // first event of each frame
+        std::vector<float>      m_Deltas;       // logged delta time of each frame
+        std::vector<InputEvent> m_Current;      // the frame being played, on the replay clock
+        EventBus                m_Bus;
+        size_t                  m_Frame      = 0;  // next frame to play
+        float                   m_FixedDelta = 1.0f / 60.0f;
+        KeyboardState           m_Keys;
+        PointerState            m_Pointer;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../FrameStats.h"
+#include "../ResourceManager.h"
+#include "../interfaces/IRenderer.h"
+#include "BitmapFont.h"
+#include "DrawQueue.h"
+#include "ResolutionController.h"
+
+namespace ugfx {
+
+    // Shared renderer front end. Implements the public draw API (sorting, sprite expansion, stats) and forwards
+    // to the backend through the protected Render* hooks.
+    class Renderer : public IRenderer {
+       public:
+        explicit Renderer(FrameStats* stats);
+        ~Renderer() override;
+
+        // IRenderer
+        void BeginDrawing() override;
+        void EndDrawing() override;
+        void Clear(Color color) override;
+        void SetBlendMode(BlendMode mode) override;
+        void SetClipRect(Rectangle rect) override;
+        void ClearClipRect() override;
+        void SetDrawSorting(bool enabled) override;
+        void PushLayer(int layer) override;
+        void PopLayer() override;
+        void SetDynamicResolution(const DynamicResolution& settings) override;
+
+        // IShapeRenderer
+        void DrawPixel(Vector2 pos, Color color) override;
+        void DrawLine(Vector2 start, Vector2 end, float thickness, Color color) override;
+        void DrawRectangle(Rectangle rec, Color color) override;
+        void DrawRectangleLines(Rectangle rec, float thickness, Color color) override;
+        void DrawCircle(Vector2 center, float radius, Color color) override;
+        void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) override;
+
+        // IImageRenderer
+        void DrawTexture(Texture tex, Vector2 pos, Color tint = {255, 255, 255, 255}) override;
+        void DrawTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint = {255, 255, 255, 255}) override;
+        void DrawTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
+                               Flip flip, Color tint = {255, 255, 255, 255}) override;
+        void DrawTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
+                           Color tint = {255, 255, 255, 255}) override;
+        void DrawGeometry(Texture tex, std::span<const Vertex2D> vertices, std::span<const int> indices = {}) override;
+        void DrawSprites(Texture atlas, std::span<const Rectangle> regions, const SpriteArrays& sprites) override;
+
+        // ITextRenderer
+        Font LoadBitmapFont(const std::string& path) override;
+        void DrawText(Font font, const std::string& text, Vector2 pos, Color color) override;
+        void DrawText(const std::string& text, Vector2 pos, int fontSize, Color color) override;
+        void DrawText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) override;
+
+        Vector2 MeasureText(Font font, const std::string& text, float fontSize,
+                            const TextOptions& options = {}) override;
+        void    DrawText(Font font, const std::string& text, Vector2 pos, float fontSize, const TextOptions& options,
+                         Color color) override;
+        void    DrawTextObject(TextObject object, Vector2 pos) override;
+
+       protected:
+        // Backend hooks
+        virtual Rectangle GetViewport() const = 0;  // visible area in draw coordinates, queried once per frame
+        // Metrics matching what RenderText draws for this font and size, or nullptr if the font is unknown
+        virtual IGlyphMetrics* GetGlyphMetrics(Font font, float fontSize) = 0;
+
+        virtual void BeginFrame() = 0;
+        virtual void EndFrame() = 0;
+        virtual void RenderClear(Color color) = 0;
+        virtual void ApplyBlendMode(BlendMode mode) = 0;
+        virtual void ApplyClipRect(const Rectangle* rect) = 0;
+        virtual void RenderPixel(Vector2 pos, Color color) = 0;
+        virtual void RenderLine(Vector2 start, Vector2 end, float thickness, Color color) = 0;
+        virtual void RenderRectangle(Rectangle rec, Color color) = 0;
+        virtual void RenderRectangleLines(Rectangle rec, float thickness, Color color) = 0;
+        virtual void RenderCircle(Vector2 center, float radius, Color color) = 0;
+        virtual void RenderTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) = 0;
+        virtual void RenderTexture(Texture tex, Vector2 pos, Color tint) = 0;
+        virtual void RenderTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) = 0;
+        virtual void RenderTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
+                                         Flip flip, Color tint) = 0;
+        virtual void RenderTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
+                                     Color tint) = 0;
+        virtual void RenderGeometry(Texture tex, std::span<const Vertex2D> vertices, std::span<const int> indices) = 0;
+        // fontSize <= 0 draws at the font's native size; an unknown font draws with the default font
+        virtual void RenderText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) = 0;
+        virtual void RenderTextObject(TextObject object, Vector2 pos) = 0;
+
+        // Bitmap fonts are handled here; backends try these first in UnloadFont and ReleaseAllResources
+        bool UnloadBitmapFont(Font font);  // false if font is not a bitmap font
+        void ReleaseBitmapFonts();
+
+        // Scale to draw the coming frame at, 1 unless dynamic resolution is on. Backends that support it draw into
+        // a target of that fraction of the window in BeginFrame, upscale it in EndFrame and store the scale they
+        // used in m_Stats->renderScale.
+        float RenderScale() const { return m_Resolution.enabled ? m_ResolutionController.Scale() : 1.0f; }
+
+        FrameStats* m_Stats = nullptr;  // never null; points at m_LocalStats when constructed without a backend
+
+       private:
+        bool Deferred() const { return m_Sorting; }
+        int  CurrentLayer() const { return m_Layers.empty() ? 0 : m_Layers.back(); }
+
+        bool              Cull(const Rectangle& bounds);
+        bool              CullText(Vector2 pos);
+        BitmapFont*       GetBitmapFont(Font font);
+        void              DrawBitmapText(BitmapFont& font, std::string_view text, Vector2 pos, float fontSize,
+                                         Color color);
+        const TextLayout* Layout(Font font, const std::string& text, float fontSize, const TextOptions& options);
+        void              UpdateCullRect();
+        DrawCommand&      Enqueue(DrawCommand::Type type, uint32_t state, const Rectangle& bounds);
+        void              Execute(const DrawCommand& cmd);
+        void              Flush();
+
+        FrameStats m_LocalStats;
+
+        DynamicResolution    m_Resolution;
+        ResolutionController m_ResolutionController;
+
+        std::chrono::steady_clock::time_point m_FrameStart;
+
+        DrawQueue        m_Queue;
+        std::vector<int> m_Layers;
+        std::string      m_TextScratch;
+        std::string      m_LineScratch;
+        TextLayoutCache  m_Layouts;
+        bool             m_Sorting = false;
+
+        ResourceManager<BitmapFont> m_BitmapFonts;
+
+        BlendMode m_BlendMode   = BlendMode::Alpha;
+        Rectangle m_ClipRect    = {};
+        bool      m_ClipEnabled = false;
+        uint16_t  m_ClipIndex   = 0;  // queue clip slot of m_ClipRect for the current frame
+
+        Rectangle m_Viewport = {};
+        Rectangle m_CullRect = {-1e9f, -1e9f, 2e9f, 2e9f};  // viewport and clip rect intersected
+
+        std::vector<Vertex2D> m_SpriteVertices;
+        std::vector<int>      m_QuadIndices;
+    };
+
+}  // namespace ugfx
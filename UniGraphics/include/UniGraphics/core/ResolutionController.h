@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace ugfx {
+
+    // Picks the dynamic resolution scale from measured frame times. Fill cost follows the pixel count, the square
+    // of the scale, so a step aims at sqrt(budget / measured). Each change is followed by a settle period that
+    // measures the new scale from scratch. Under vsync or a frame cap the frame time cannot drop below the budget,
+    // so headroom is found by probing a small step up now and then, backing off further each time a probe misses.
+    class ResolutionController {
+       public:
+        void Configure(float targetMs, float minScale, float maxScale) {
+            m_TargetMs = std::max(targetMs, 1.0f);
+            m_MinScale = std::clamp(minScale, 0.1f, 1.0f);
+            m_MaxScale = std::clamp(maxScale, m_MinScale, 1.0f);
+            m_Scale    = std::clamp(m_Scale, m_MinScale, m_MaxScale);
+            m_Samples  = 0;
+        }
+
+        float Scale() const { return m_Scale; }
+
+        // Feeds the time of the frame just drawn at Scale(); budgetMs overrides the target when it is longer
+        float Update(float frameMs, float budgetMs = 0.0f) {
+            const float target = std::max(m_TargetMs, budgetMs);
+
+            m_Average = m_Samples == 0 ? frameMs : m_Average + (frameMs - m_Average) * kSmoothing;
+            if (++m_Samples < kSettleFrames)
+                return m_Scale;
+
+            const bool probed = m_Probing;  // first decision after a probe step
+            m_Probing         = false;
+
+            const float aim  = target * kAim;
+            float       next = m_Scale;
+            if (m_Average > target * kOverBudget) {
+                next = m_Scale * std::max(kMaxStepDown, std::sqrt(aim / m_Average));
+                if (probed) {
+                    next          = m_ProbeFrom;  // a missed vsync doubles the frame time, so don't scale by it
+                    m_ProbeFrames = std::min(m_ProbeFrames * 2, kMaxProbeFrames);
+                }
+            } else if (m_Average < target * kUnderBudget) {
+                next = m_Scale * std::min(kMaxStepUp, std::sqrt(aim / m_Average));
+            } else {
+                if (probed)
+                    m_ProbeFrames = kProbeFrames;
+                if (m_Samples >= m_ProbeFrames) {
+                    next        = m_Scale + kProbeStep;
+                    m_ProbeFrom = m_Scale;
+                    m_Probing   = true;
+                }
+            }
+
+            next               = std::clamp(next, m_MinScale, m_MaxScale);
+            const bool atLimit = next == m_MinScale || next == m_MaxScale;
+            if (next != m_Scale && (atLimit || std::abs(next - m_Scale) >= kMinChange)) {
+                m_Scale   = next;
+                m_Samples = 0;
+            } else {
+                m_Probing = false;
+            }
+            return m_Scale;
+        }
+
+       private:
+        static constexpr float kSmoothing      = 0.2f;
+        static constexpr float kAim            = 0.9f;  // steps aim a little under the budget
+        static constexpr float kOverBudget     = 1.05f;
+        static constexpr float kUnderBudget    = 0.8f;
+        static constexpr float kMaxStepDown    = 0.8f;
+        static constexpr float kMaxStepUp      = 1.1f;
+        static constexpr float kProbeStep      = 0.05f;
+        static constexpr float kMinChange      = 0.01f;
+        static constexpr int   kSettleFrames   = 8;
+        static constexpr int   kProbeFrames    = 60;
+        static constexpr int   kMaxProbeFrames = 960;
+
+        float m_TargetMs    = 1000.0f / 60.0f;
+        float m_MinScale    = 0.5f;
+        float m_MaxScale    = 1.0f;
+        float m_Scale       = 1.0f;
+        float m_ProbeFrom   = 1.0f;
+        float m_Average     = 0.0f;
+        int   m_Samples     = 0;
+        int   m_ProbeFrames = kProbeFrames;
+        bool  m_Probing     = false;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,125 @@
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UGFX_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define UGFX_SIMD_SSE2 0
+#endif
+
+namespace ugfx::simd {
+
+    // 4-wide float helpers with a scalar fallback, so callers can be written once.
+#if UGFX_SIMD_SSE2
+    using Float4 = __m128;
+
+    inline Float4 Load(const float* p) {
+        return _mm_loadu_ps(p);
+    }
+    inline void Store(float* p, Float4 v) {
+        _mm_storeu_ps(p, v);
+    }
+    inline Float4 Set1(float v) {
+        return _mm_set1_ps(v);
+    }
+    inline Float4 Add(Float4 a, Float4 b) {
+        return _mm_add_ps(a, b);
+    }
+    inline Float4 Sub(Float4 a, Float4 b) {
+        return _mm_sub_ps(a, b);
+    }
+    inline Float4 Mul(Float4 a, Float4 b) {
+        return _mm_mul_ps(a, b);
+    }
+    inline Float4 Min(Float4 a, Float4 b) {
+        return _mm_min_ps(a, b);
+    }
+    inline Float4 Max(Float4 a, Float4 b) {
+        return _mm_max_ps(a, b);
+    }
+    inline Float4 Round(Float4 v) {
+        return _mm_cvtepi32_ps(_mm_cvtps_epi32(v));  // round-to-nearest, inputs are small
+    }
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+    inline Float4 Greater(Float4 a, Float4 b) {
+        return _mm_cmpgt_ps(a, b);
+    }
+    inline Float4 Less(Float4 a, Float4 b) {
+        return _mm_cmplt_ps(a, b);
+    }
+#else
+    struct Float4 {
+        float v[4];
+    };
+
+    inline Float4 Load(const float* p) {
+        return {{p[0], p[1], p[2], p[3]}};
+    }
+    inline void Store(float* p, Float4 a) {
+        for (int i = 0; i < 4; ++i)
+            p[i] = a.v[i];
+    }
+    inline Float4 Set1(float v) {
+        return {{v, v, v, v}};
+    }
+
+#define UGFX_SIMD_LANEWISE(name, expr)           \
+    inline Float4 name(Float4 a, Float4 b) {     \
+        Float4 r;                                \
+        for (int i = 0; i < 4; ++i)              \
+            r.v[i] = (expr);                     \
+        return r;                                \
+    }
+    UGFX_SIMD_LANEWISE(Add, a.v[i] + b.v[i])
+    UGFX_SIMD_LANEWISE(Sub, a.v[i] - b.v[i])
+    UGFX_SIMD_LANEWISE(Mul, a.v[i] * b.v[i])
+    UGFX_SIMD_LANEWISE(Min, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+    UGFX_SIMD_LANEWISE(Max, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+    UGFX_SIMD_LANEWISE(Greater, a.v[i] > b.v[i] ? 1.0f : 0.0f)
+    UGFX_SIMD_LANEWISE(Less, a.v[i] < b.v[i] ? 1.0f : 0.0f)
+#undef UGFX_SIMD_LANEWISE
+
+    inline Float4 Round(Float4 a) {
+        Float4 r;
+        for (int i = 0; i < 4; ++i)
+            r.v[i] = static_cast<float>(static_cast<int>(a.v[i] + (a.v[i] >= 0.0f ? 0.5f : -0.5f)));
+        return r;
+    }
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) {
+        Float4 r;
+        for (int i = 0; i < 4; ++i)
+            r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+        return r;
+    }
+#endif
+
+    // sin/cos of an angle given in turns (1.0 = 360 degrees). Max error is about 2e-4, plenty for sprite vertices.
+    inline void SinCosTurns(Float4 turns, Float4& outSin, Float4& outCos) {
+        const Float4 half    = Set1(0.5f);
+        const Float4 quarter = Set1(0.25f);
+        const Float4 twoPi   = Set1(6.28318530718f);
+
+        auto sinReduced = [&](Float4 t) {
+            // t in [-0.5, 0.5]; fold into [-0.25, 0.25] using sin(pi - x) = sin(x)
+            t = Select(Greater(t, quarter), Sub(half, t), t);
+            t = Select(Less(t, Set1(-0.25f)), Sub(Set1(-0.5f), t), t);
+
+            Float4 x  = Mul(t, twoPi);
+            Float4 x2 = Mul(x, x);
+            Float4 p  = Set1(-1.0f / 5040.0f);
+            p         = Add(Mul(p, x2), Set1(1.0f / 120.0f));
+            p         = Add(Mul(p, x2), Set1(-1.0f / 6.0f));
+            p         = Add(Mul(p, x2), Set1(1.0f));
+            return Mul(p, x);
+        };
+
+        Float4 t = Sub(turns, Round(turns));
+        outSin   = sinReduced(t);
+
+        Float4 c = Add(t, quarter);
+        outCos   = sinReduced(Select(Greater(c, half), Sub(c, Set1(1.0f)), c));
+    }
+
+}  // namespace ugfx::simd
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "../interfaces/IRenderer.h"
+
+namespace ugfx {
+
+    // Expands SoA sprite data into four vertices per sprite (TL, TR, BL, BR), four sprites per iteration.
+    // Returns the number of sprites written; vertices is resized to 4 * that count.
+    size_t BuildSpriteQuads(const SpriteArrays& sprites, std::span<const Rectangle> regions, Vector2 textureSize,
+                            std::vector<Vertex2D>& vertices);
+
+    // Drops quads whose corners all lie outside view, compacting the rest in place. Returns the quads kept.
+    size_t CullSpriteQuads(std::vector<Vertex2D>& vertices, size_t quadCount, const Rectangle& view);
+
+    // Grows a shared quad index list (0 1 2, 2 1 3, ...) to cover at least quadCount quads.
+    void BuildQuadIndices(size_t quadCount, std::vector<int>& indices);
+
+}  // namespace ugfx
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../CommonTypes.h"
+
+namespace ugfx {
+
+    enum class TextAlign { Left, Center, Right };
+
+    struct TextOptions {
+        float     wrapWidth   = 0.0f;  // break lines at spaces to fit this width, 0 = only at '\n'
+        TextAlign align       = TextAlign::Left;  // within wrapWidth, or the widest line when not wrapping
+        float     lineSpacing = 1.0f;  // multiple of the font's line height
+    };
+
+    // Per-font glyph metrics in pixels at BaseSize(). Backends hand out the same data their draw path uses, so
+    // measured text matches drawn text.
+    class IGlyphMetrics {
+       public:
+        virtual ~IGlyphMetrics() = default;
+
+        virtual int   BaseSize() const            = 0;
+        virtual float LineHeight() const          = 0;
+        virtual float Advance(uint32_t codepoint) = 0;
+        virtual float Kerning(uint32_t left, uint32_t right) { return 0.0f; }
+
+        // Metrics of a draw path that shapes whole runs (GPOS kerning, ligatures) measure a run as a unit, and
+        // layout breaks lines on those widths instead of summing Advance and Kerning per code point
+        virtual bool  ShapesRuns() const { return false; }
+        virtual float MeasureRun(std::string_view run) { return 0.0f; }
+    };
+
+    struct TextLine {
+        uint32_t begin = 0, end = 0;  // byte range in the source string, trailing spaces excluded
+        float    x = 0.0f, y = 0.0f;  // offset from the layout origin, alignment applied
+        float    width = 0.0f;
+    };
+
+    struct TextLayout {
+        std::vector<TextLine> lines;
+        Vector2               size = {0.0f, 0.0f};
+    };
+
+    // Breaks text into lines at '\n' and, when wrapping, at the last space that fits. Words wider than the wrap
+    // width are split between code points.
+    void LayoutText(IGlyphMetrics& metrics, std::string_view text, float fontSize, const TextOptions& options,
+                    TextLayout& out);
+
+    // Layouts keyed by (font, size, options, text). A label that is laid out every frame costs one hash lookup;
+    // once the cache is over capacity, entries not used during the previous frame are dropped.
+    class TextLayoutCache {
+       public:
+        explicit TextLayoutCache(size_t capacity = 1024) : m_Capacity(capacity) {}
+
+        const TextLayout& Get(int font, IGlyphMetrics& metrics, std::string_view text, float fontSize,
+                              const TextOptions& options);
+        void              NextFrame();
+        void              Clear() { m_Entries.clear(); }
+        size_t            Size() const { return m_Entries.size(); }
+
+       private:
+        struct Entry {
+            int         font     = 0;
+            float       fontSize = 0.0f;
+            TextOptions options;
+            std::string text;
+            TextLayout  layout;
+            uint64_t    lastUsed = 0;
+        };
+
+        size_t                              m_Capacity = 0;
+        uint64_t                            m_Frame    = 0;
+        std::unordered_map<uint64_t, Entry> m_Entries;
+    };
+
+}  // namespace ugfx
@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "../CommonTypes.h"
+#include "../FrameStats.h"
 #include "IInput.h"
 #include "IRenderer.h"
 #include "IWindow.h"
@@ -17,7 +18,9 @@ namespace ugfx {
         virtual IInput*    GetInput()    = 0;
         virtual IRenderer* GetRenderer() = 0;
 
-        BackendType GetBackendType() = 0;
+        virtual BackendType       GetBackendType()      = 0;
+        virtual const FrameStats& GetFrameStats() const = 0;
+        virtual FrameStats&       GetFrameStats()       = 0;
     };
 
     std::unique_ptr<IGraphicsBackend> CreateBackend();
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
 #include <string>
 
 #include "../CommonTypes.h"
+#include "../core/TextLayout.h"
 
 namespace ugfx {
 
@@ -18,6 +21,18 @@ namespace ugfx {
         virtual void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color)      = 0;
     };
 
+    // Parallel per-sprite arrays, e.g. straight from ECS component storage. Only x and y are required; the
+    // optional arrays are either empty or the same length as x.
+    struct SpriteArrays {
+        std::span<const float>    x;
+        std::span<const float>    y;
+        std::span<const float>    rotation;  // degrees, default 0
+        std::span<const float>    scale;     // default 1
+        std::span<const Color>    tint;      // default white
+        std::span<const uint16_t> region;    // index into the regions span, default 0
+        Vector2                   origin = {0.5f, 0.5f};  // pivot, normalized to the region size
+    };
+
     class IImageRenderer {
        public:
         virtual ~IImageRenderer()                                                                = default;
@@ -29,6 +44,12 @@ namespace ugfx {
                                        Flip flip, Color tint = {255, 255, 255, 255})                               = 0;
         virtual void DrawTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
                                    Color tint = {255, 255, 255, 255})                                              = 0;
+
+        // Triangle list; an empty index span draws the vertices in order. Texture{} draws untextured geometry.
+        virtual void DrawGeometry(Texture tex, std::span<const Vertex2D> vertices,
+                                  std::span<const int> indices = {}) = 0;
+        // An empty regions span uses the whole texture for every sprite.
+        virtual void DrawSprites(Texture atlas, std::span<const Rectangle> regions, const SpriteArrays& sprites) = 0;
     };
 
     class ITextRenderer {
@@ -39,6 +60,46 @@ namespace ugfx {
         virtual void UnloadFont(Font font)                                                     = 0;
         virtual void DrawText(Font font, const std::string& text, Vector2 pos, Color color)    = 0;
         virtual void DrawText(const std::string& text, Vector2 pos, int fontSize, Color color) = 0;
+
+        // Distance field fonts rasterize each glyph once into a shared atlas and draw at any size without
+        // re-rasterizing. Given a size, the default font draws through a distance field of the embedded Lexend on
+        // every backend.
+        virtual Font LoadSdfFont(const std::string& path)                                                    = 0;
+        virtual void DrawText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) = 0;
+
+        // Text is UTF-8. Code points a distance field font lacks are taken from its fallbacks, in the order added;
+        // Font{} adds to the default font's distance field, which every backend builds from the embedded Lexend.
+        // Raster fonts have no fallbacks.
+        virtual bool AddFallbackFont(Font font, const std::string& path) = 0;
+
+        // Pre-baked AngelCode BMFont (text .fnt plus page images beside it), for HUD text that changes every frame:
+        // drawing is quad expansion with no rasterization. Draws at its baked size unless given one; UnloadFont
+        // frees it.
+        virtual Font LoadBitmapFont(const std::string& path) = 0;
+
+        // Text rendered once and redrawn with a single textured draw; destroy objects before unloading their font.
+        // Plain raster DrawText calls are served from an LRU cache of the same, keyed by font, size and text and
+        // capped at a byte budget.
+        virtual TextObject CreateTextObject(Font font, const std::string& text, float fontSize, Color color) = 0;
+        virtual void       DrawTextObject(TextObject object, Vector2 pos)                                    = 0;
+        virtual void       DestroyTextObject(TextObject object)                                              = 0;
+        virtual void       SetTextCacheBudget(size_t bytes)                                                  = 0;
+
+        // Laid out with wrapping, alignment and line spacing; layouts are cached, so static labels cost one lookup.
+        // fontSize <= 0 uses the font's native size, as above.
+        virtual Vector2 MeasureText(Font font, const std::string& text, float fontSize,
+                                    const TextOptions& options = {})      = 0;
+        virtual void    DrawText(Font font, const std::string& text, Vector2 pos, float fontSize,
+                                 const TextOptions& options, Color color) = 0;
+    };
+
+    // Draws go to an internal target whose scale follows the measured frame time and are upscaled to the window at
+    // present. Draw coordinates (and so input coordinates) stay in window units at any scale.
+    struct DynamicResolution {
+        bool  enabled       = false;
+        float targetFrameMs = 1000.0f / 60.0f;
+        float minScale      = 0.5f;
+        float maxScale      = 1.0f;
     };
 
     class IRenderer : public IShapeRenderer, public IImageRenderer, public ITextRenderer {
@@ -50,6 +111,32 @@ namespace ugfx {
         virtual void  Clear(Color color)    = 0;
         virtual void  ReleaseAllResources() = 0;
         virtual void* GetHandle() const     = 0;
+
+        // Render state, kept until changed
+        virtual void SetBlendMode(BlendMode mode) = 0;
+        virtual void SetClipRect(Rectangle rect)  = 0;
+        virtual void ClearClipRect()              = 0;
+
+        // Deferred mode: draws are queued until EndDrawing and reordered to batch by texture, font, blend mode
+        // and clip. Layers draw in ascending order; draws that overlap within a layer keep submission order.
+        virtual void SetDrawSorting(bool enabled) = 0;
+        virtual void PushLayer(int layer)         = 0;
+        virtual void PopLayer()                   = 0;
+
+        virtual void SetDynamicResolution(const DynamicResolution& settings) = 0;
+    };
+
+    // Scoped PushLayer/PopLayer
+    class LayerScope {
+       public:
+        LayerScope(IRenderer& renderer, int layer) : m_Renderer(renderer) { m_Renderer.PushLayer(layer); }
+        ~LayerScope() { m_Renderer.PopLayer(); }
+
+        LayerScope(const LayerScope&)            = delete;
+        LayerScope& operator=(const LayerScope&) = delete;
+
+       private:
+        IRenderer& m_Renderer;
     };
 
 }  // namespace ugfx
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -8,20 +9,33 @@
 namespace ugfx {
 
     enum class WindowFlags : uint32_t {
-        None        = 0,
-        Fullscreen  = 1 << 0,
-        Borderless  = 1 << 1,
-        Resizable   = 1 << 2,
-        VSync       = 1 << 3,
-        Hidden      = 1 << 4,
-        AlwaysOnTop = 1 << 5
+        None          = 0,
+        Fullscreen    = 1 << 0,
+        Borderless    = 1 << 1,
+        Resizable     = 1 << 2,
+        VSync         = 1 << 3,
+        Hidden        = 1 << 4,
+        AlwaysOnTop   = 1 << 5,
+        AdaptiveVSync = 1 << 6,  // vsync, but late frames present immediately instead of waiting a whole refresh
         // Add more as needed
     };
 
+    enum class VSyncMode { Off, On, Adaptive };
+
+    // Frame rate cap for each window activity: > 0 caps the rate, 0 stops rendering (PollEvents blocks until the
+    // activity changes), < 0 keeps the rate set with SetTargetFPS.
+    struct FrameRatePolicy {
+        int focused   = -1;
+        int unfocused = -1;
+        int minimized = -1;
+    };
+
     class IWindow {
        public:
         virtual ~IWindow() = default;
 
+        using ActivityCallback = std::function<void(WindowActivity previous, WindowActivity current)>;
+
         virtual bool                Create(const std::string& title, int width, int height, WindowFlags flags) = 0;
         virtual void                SetTitle(const std::string& title)                                         = 0;
         virtual std::pair<int, int> GetSize() const                                                            = 0;
@@ -29,9 +43,29 @@ namespace ugfx {
         virtual void                PollEvents()                                                               = 0;
         virtual void                Shutdown()                                                                 = 0;
         virtual void                SetTargetFPS(int fps)                                                      = 0;
+        virtual void                SetVSync(VSyncMode mode)                                                   = 0;
         virtual float               GetDeltaTime() const                                                       = 0;
         virtual uint32_t            GetTicks() const                                                           = 0;
         virtual void*               GetHandle() const                                                          = 0;
+
+        // Event-driven mode: PollEvents blocks until input, a redraw request or a redraw timer instead of returning
+        // every frame, and NeedsRedraw tells whether the frame that follows has to be rendered. Frames render
+        // continuously while any animation is running.
+        virtual void SetWaitEvents(bool enabled) = 0;
+        virtual bool NeedsRedraw() const         = 0;
+        // Schedules a frame delayMs from now; safe to call from any thread and wakes a blocked PollEvents
+        virtual void RequestRedraw(uint32_t delayMs = 0) = 0;
+        virtual void BeginAnimation()                    = 0;
+        virtual void EndAnimation()                      = 0;
+
+        // Focus, minimize and visibility tracking; transitions are reported from PollEvents
+        virtual void           SetFrameRatePolicy(const FrameRatePolicy& policy)    = 0;
+        virtual WindowActivity GetActivity() const                                  = 0;
+        virtual void           RegisterActivityCallback(ActivityCallback callback) = 0;
+
+        // Late latch: PollEvents does the frame pacing wait before pumping events instead of after, and under vsync
+        // also delays the frame start by the slack recent presents left, so the frame renders on fresh input
+        virtual void SetLateLatch(bool enabled) = 0;
     };
 
     inline WindowFlags operator|(WindowFlags a, WindowFlags b) {
@@ -0,0 +1,662 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "UniGraphics/UniGraphics.h"
+
+// Usage: Benchmarks <scene> [frames] [--record <log> | --replay <log>] [--late-latch]
+// Each scene renders a fixed number of frames and prints the average CPU time per frame. --record writes the
+// input of every frame to a log; --replay drives the scenes from a log in a hidden window instead, so runs see the
+// same input on every backend. --late-latch runs with vsync and late-latched input to compare input latency.
+
+// ------------------- Helper Structs & Functions -------------------
+
+struct BackendContext {
+    std::unique_ptr<ugfx::IGraphicsBackend> backend;
+    ugfx::IWindow*                          window   = nullptr;
+    ugfx::IInput*                           input    = nullptr;  // the replay when replaying
+    ugfx::IRenderer*                        renderer = nullptr;
+
+    std::unique_ptr<ugfx::ReplayInput> replay;
+    ugfx::InputRecorder                recorder;
+};
+
+struct BenchConfig {
+    int         frames = 600;
+    int         width  = 1280;
+    int         height = 720;
+    std::string assetDir;
+    std::string recordPath;
+    std::string replayPath;
+    bool        lateLatch = false;
+};
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point kProcessStart = Clock::now();  // static initialization, as close to process start as we get
+
+bool InitBackend(BackendContext& ctx, const BenchConfig& cfg) {
+    ctx.backend = ugfx::CreateBackend();
+    if (!ctx.backend)
+        return false;
+
+    ctx.window   = ctx.backend->GetWindow();
+    ctx.input    = ctx.backend->GetInput();
+    ctx.renderer = ctx.backend->GetRenderer();
+    if (!ctx.window || !ctx.input || !ctx.renderer)
+        return false;
+
+    const ugfx::WindowFlags flags = cfg.replayPath.empty() ? ugfx::WindowFlags::None : ugfx::WindowFlags::Hidden;
+    if (!ctx.window->Create("UniGraphics Benchmarks", cfg.width, cfg.height, flags))
+        return false;
+
+    if (!cfg.replayPath.empty()) {
+        ctx.replay = std::make_unique<ugfx::ReplayInput>();
+        if (!ctx.replay->Load(cfg.replayPath))
+            return false;
+        ctx.input = ctx.replay.get();
+    }
+    if (!cfg.recordPath.empty() && !ctx.recorder.Open(cfg.recordPath))
+        return false;
+
+    ctx.window->SetTargetFPS(0);  // measure raw throughput
+    if (cfg.lateLatch) {
+        ctx.window->SetVSync(ugfx::VSyncMode::On);
+        ctx.window->SetLateLatch(true);
+    }
+    return true;
+}
+
+// Runs drawFrame for cfg.frames frames and reports the average frame time.
+template <typename DrawFn>
+void RunFrames(BackendContext& ctx, const BenchConfig& cfg, const char* label, DrawFn&& drawFrame) {
+    auto start = Clock::now(), last = start;
+    for (int frame = 0; frame < cfg.frames && !ctx.window->ShouldClose(); ++frame) {
+        ctx.window->PollEvents();
+        if (ctx.replay) {
+            ctx.replay->BeginFrame();
+            ctx.replay->EndFrame();
+        }
+        if (ctx.recorder.IsOpen()) {
+            const auto now = Clock::now();
+            ctx.recorder.RecordFrame(std::chrono::duration<float>(now - last).count(), ctx.input->GetEvents());
+            last = now;
+        }
+        ctx.renderer->BeginDrawing();
+        ctx.renderer->Clear({20, 20, 30, 255});
+        drawFrame(frame);
+        ctx.renderer->EndDrawing();
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout << label << ": " << ms / cfg.frames << " ms/frame\n";
+
+    // Counters of the last frame
+    const ugfx::FrameStats& stats = ctx.backend->GetFrameStats();
+    std::cout << "    state changes: " << stats.stateChanges << " (elided " << stats.stateChangesElided << ")\n";
+    std::cout << "    draw calls: " << stats.drawCalls << " (sorted " << stats.drawsSorted << ", culled "
+              << stats.drawsCulled << ")\n";
+    std::cout << "    cpu " << stats.cpuTimeMs << " ms, present wait " << stats.presentWaitMs << " ms\n";
+    if (stats.renderScale < 1.0f)
+        std::cout << "    render scale: " << stats.renderScale << "\n";
+    if (stats.inputLatencyMs > 0.0f)
+        std::cout << "    input latency " << stats.inputLatencyMs << " ms, pointer " << stats.pointerLatencyMs
+                  << " ms, latch delay " << stats.latchDelayMs << " ms\n";
+    if (stats.textCacheHits + stats.textCacheMisses > 0)
+        std::cout << "    text cache: " << stats.textCacheHits << " hits, " << stats.textCacheMisses << " misses, "
+                  << stats.textCacheBytes / 1024 << " KiB\n";
+}
+
+// Presents a first frame with a default-font label, as an application would, and reports the time from process
+// start along with the backend's startup phases.
+void ReportStartup(BackendContext& ctx) {
+    ctx.window->PollEvents();
+    ctx.renderer->BeginDrawing();
+    ctx.renderer->Clear({20, 20, 30, 255});
+    ctx.renderer->DrawText(ugfx::Font{}, "UniGraphics", {10.0f, 10.0f}, {230, 230, 230, 255});
+    ctx.renderer->EndDrawing();
+    const double total = std::chrono::duration<double, std::milli>(Clock::now() - kProcessStart).count();
+
+    const ugfx::StartupStats& s = ctx.backend->GetFrameStats().startup;
+    std::cout << "startup: " << total << " ms from process start to first frame\n";
+    std::cout << "    backend init " << s.backendInit << " ms, window " << s.windowCreate << " ms, renderer "
+              << s.rendererCreate << " ms, fonts " << s.fontInit << " ms\n";
+    std::cout << "    first present " << s.firstPresent << " ms after backend construction\n";
+}
+
+// ------------------- Scenes -------------------
+
+// 200k sprites from SoA storage: per-sprite DrawTextureEx vs one DrawSprites submission.
+void SceneSprites(BackendContext& ctx, const BenchConfig& cfg) {
+    ugfx::Texture tex = ctx.renderer->LoadTexture(cfg.assetDir + "/BRICK_2B.png");
+    if (tex.id <= 0) {
+        std::cerr << "Missing texture asset\n";
+        return;
+    }
+
+    const size_t                          count = 200000;
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> px(0.0f, float(cfg.width)), py(0.0f, float(cfg.height)), pr(0.0f, 360.0f);
+
+    std::vector<float>       x(count), y(count), rot(count), scale(count, 0.25f);
+    std::vector<ugfx::Color> tint(count);
+    for (size_t i = 0; i < count; ++i) {
+        x[i]    = px(rng);
+        y[i]    = py(rng);
+        rot[i]  = pr(rng);
+        tint[i] = {static_cast<unsigned char>(i), static_cast<unsigned char>(i >> 8), 200, 255};
+    }
+
+    ugfx::Vector2 origin = {tex.width * 0.5f, tex.height * 0.5f};
+    RunFrames(ctx, cfg, "sprites/DrawTextureEx", [&](int frame) {
+        for (size_t i = 0; i < count; ++i)
+            ctx.renderer->DrawTextureEx(tex, {x[i], y[i]}, origin, rot[i] + frame, scale[i], ugfx::Flip::None,
+                                        tint[i]);
+    });
+
+    RunFrames(ctx, cfg, "sprites/DrawSprites", [&](int frame) {
+        for (size_t i = 0; i < count; ++i)
+            rot[i] += 1.0f;
+        ugfx::SpriteArrays sprites;
+        sprites.x        = x;
+        sprites.y        = y;
+        sprites.rotation = rot;
+        sprites.scale    = scale;
+        sprites.tint     = tint;
+        ctx.renderer->DrawSprites(tex, {}, sprites);
+    });
+
+    ctx.renderer->UnloadTexture(tex);
+}
+
+// 100k same-colored rectangles: every draw after the first hits the cached draw color.
+void SceneMonochrome(BackendContext& ctx, const BenchConfig& cfg) {
+    RunFrames(ctx, cfg, "monochrome/DrawRectangle", [&](int frame) {
+        for (int i = 0; i < 100000; ++i) {
+            float x = float((i * 37 + frame) % cfg.width);
+            float y = float((i * 91) % cfg.height);
+            ctx.renderer->DrawRectangle({x, y, 4, 4}, {0, 200, 180, 255});
+        }
+    });
+}
+
+// 100k draws of one texture with one tint: color/alpha mods are set once per frame.
+void SceneSingleTexture(BackendContext& ctx, const BenchConfig& cfg) {
+    ugfx::Texture tex = ctx.renderer->LoadTexture(cfg.assetDir + "/BRICK_2B.png");
+    if (tex.id <= 0) {
+        std::cerr << "Missing texture asset\n";
+        return;
+    }
+
+    RunFrames(ctx, cfg, "single-texture/DrawTexture", [&](int frame) {
+        for (int i = 0; i < 100000; ++i) {
+            float x = float((i * 37 + frame) % cfg.width);
+            float y = float((i * 91) % cfg.height);
+            ctx.renderer->DrawTexture(tex, {x, y}, {255, 255, 255, 255});
+        }
+    });
+
+    ctx.renderer->UnloadTexture(tex);
+}
+
+// Layered draw sorting: DrawQueue push/sort cost for 100k commands, then interleaved textures with sorting off/on.
+void SceneSort(BackendContext& ctx, const BenchConfig& cfg) {
+    const int                             count = 100000;
+    std::mt19937                          rng(7);
+    std::uniform_real_distribution<float> px(0.0f, float(cfg.width)), py(0.0f, float(cfg.height));
+    std::uniform_int_distribution<int>    pt(1, 8), pl(0, 3);
+
+    std::vector<ugfx::Rectangle> bounds(count);
+    std::vector<uint32_t>        states(count);
+    std::vector<int>             layers(count);
+    for (int i = 0; i < count; ++i) {
+        bounds[i] = {px(rng), py(rng), 16.0f, 16.0f};
+        states[i] = static_cast<uint32_t>(pt(rng));
+        layers[i] = pl(rng);
+    }
+
+    ugfx::DrawQueue   queue;
+    ugfx::DrawCommand cmd;
+    const int         iterations = std::max(1, cfg.frames / 10);
+    double            pushMs = 0.0, sortMs = 0.0;
+    for (int it = 0; it < iterations; ++it) {
+        queue.Clear();
+        auto start = Clock::now();
+        for (int i = 0; i < count; ++i)
+            queue.Push(cmd, layers[i], states[i], bounds[i]);
+        auto pushed = Clock::now();
+        queue.Sort();
+        auto sorted = Clock::now();
+        pushMs += std::chrono::duration<double, std::milli>(pushed - start).count();
+        sortMs += std::chrono::duration<double, std::milli>(sorted - pushed).count();
+    }
+    std::cout << "sort/DrawQueue 100k: push " << pushMs / iterations << " ms, sort " << sortMs / iterations
+              << " ms\n";
+
+    // Two textures drawn alternately, as a naive scene would submit them
+    ugfx::Texture texA = ctx.renderer->LoadTexture(cfg.assetDir + "/BRICK_2B.png");
+    ugfx::Texture texB = ctx.renderer->LoadTexture(cfg.assetDir + "/BRICK_2B.png");
+    if (texA.id <= 0 || texB.id <= 0) {
+        std::cerr << "Missing texture asset\n";
+        return;
+    }
+
+    auto drawInterleaved = [&](int frame) {
+        for (int i = 0; i < 20000; ++i) {
+            ugfx::LayerScope layer(*ctx.renderer, i % 4);
+            float            x = float((i * 37 + frame) % cfg.width);
+            float            y = float((i * 91) % cfg.height);
+            ctx.renderer->DrawTexture(i % 2 ? texA : texB, {x, y}, {255, 255, 255, 255});
+        }
+    };
+
+    RunFrames(ctx, cfg, "sort/interleaved unsorted", drawInterleaved);
+    ctx.renderer->SetDrawSorting(true);
+    RunFrames(ctx, cfg, "sort/interleaved sorted", drawInterleaved);
+    ctx.renderer->SetDrawSorting(false);
+
+    ctx.renderer->UnloadTexture(texA);
+    ctx.renderer->UnloadTexture(texB);
+}
+
+// 100k rotated sprites spread over a 4096x4096 world, viewed through a panning window-sized camera.
+void SceneCulling(BackendContext& ctx, const BenchConfig& cfg) {
+    ugfx::Texture tex = ctx.renderer->LoadTexture(cfg.assetDir + "/BRICK_2B.png");
+    if (tex.id <= 0) {
+        std::cerr << "Missing texture asset\n";
+        return;
+    }
+
+    const size_t                          count = 100000;
+    const float                           world = 4096.0f;
+    std::mt19937                          rng(3);
+    std::uniform_real_distribution<float> pw(0.0f, world), pr(0.0f, 360.0f);
+
+    std::vector<float> x(count), y(count), rot(count), scale(count, 0.25f);
+    for (size_t i = 0; i < count; ++i) {
+        x[i]   = pw(rng);
+        y[i]   = pw(rng);
+        rot[i] = pr(rng);
+    }
+
+    auto camera = [&](int frame) {
+        float t = frame * 0.01f;
+        return ugfx::Vector2{(world - cfg.width) * (0.5f + 0.5f * std::sin(t)),
+                             (world - cfg.height) * (0.5f + 0.5f * std::cos(t))};
+    };
+
+    ugfx::Vector2 origin = {tex.width * 0.5f, tex.height * 0.5f};
+    RunFrames(ctx, cfg, "culling/DrawTextureEx", [&](int frame) {
+        ugfx::Vector2 cam = camera(frame);
+        for (size_t i = 0; i < count; ++i)
+            ctx.renderer->DrawTextureEx(tex, {x[i] - cam.x, y[i] - cam.y}, origin, rot[i], scale[i], ugfx::Flip::None);
+    });
+
+    std::vector<float> sx(count), sy(count);
+    RunFrames(ctx, cfg, "culling/DrawSprites", [&](int frame) {
+        ugfx::Vector2 cam = camera(frame);
+        for (size_t i = 0; i < count; ++i) {
+            sx[i] = x[i] - cam.x;
+            sy[i] = y[i] - cam.y;
+        }
+        ugfx::SpriteArrays sprites;
+        sprites.x        = sx;
+        sprites.y        = sy;
+        sprites.rotation = rot;
+        sprites.scale    = scale;
+        ctx.renderer->DrawSprites(tex, {}, sprites);
+    });
+
+    ctx.renderer->UnloadTexture(tex);
+}
+
+// 1M retained sprites in a SpriteScene: 1% move each frame, only visible cells are drawn, plus a pick per frame.
+void SceneRetained(BackendContext& ctx, const BenchConfig& cfg) {
+    ugfx::Texture tex = ctx.renderer->LoadTexture(cfg.assetDir + "/BRICK_2B.png");
+    if (tex.id <= 0) {
+        std::cerr << "Missing texture asset\n";
+        return;
+    }
+
+    const size_t                          count = 1000000;
+    const float                           world = 16384.0f;
+    std::mt19937                          rng(5);
+    std::uniform_real_distribution<float> pw(0.0f, world), pr(0.0f, 360.0f), pd(-8.0f, 8.0f);
+
+    ugfx::SpriteScene           scene(tex);
+    std::vector<ugfx::SpriteId> ids(count);
+    auto                        start = Clock::now();
+    for (size_t i = 0; i < count; ++i)
+        ids[i] = scene.Add({{pw(rng), pw(rng)}, pr(rng), 0.25f});
+    std::cout << "retained/build 1M: "
+              << std::chrono::duration<double, std::milli>(Clock::now() - start).count() << " ms\n";
+
+    std::vector<ugfx::SpriteId> hits;
+    size_t                      picked = 0;
+    RunFrames(ctx, cfg, "retained/SpriteScene", [&](int frame) {
+        for (size_t i = frame % 100; i < count; i += 100) {
+            ugfx::SpriteDesc desc = scene.Get(ids[i]);
+            scene.SetPosition(ids[i], {desc.position.x + pd(rng), desc.position.y + pd(rng)});
+        }
+
+        float           t    = frame * 0.01f;
+        ugfx::Rectangle view = {(world - cfg.width) * (0.5f + 0.5f * std::sin(t)),
+                                (world - cfg.height) * (0.5f + 0.5f * std::cos(t)), float(cfg.width),
+                                float(cfg.height)};
+        scene.Draw(*ctx.renderer, view);
+
+        scene.QueryPoint({view.x + view.width * 0.5f, view.y + view.height * 0.5f}, hits);
+        picked += hits.size();
+    });
+    std::cout << "    picked " << picked << " sprites in total\n";
+
+    ctx.renderer->UnloadTexture(tex);
+}
+
+// Scrolling a 256x256 map of 16px tiles: per-tile DrawTextureRegion vs TileMap chunks, editing a few tiles a frame.
+void SceneTileMap(BackendContext& ctx, const BenchConfig& cfg) {
+    ugfx::Texture tileset = ctx.renderer->LoadTexture(cfg.assetDir + "/BRICK_2B.png");
+    if (tileset.id <= 0) {
+        std::cerr << "Missing texture asset\n";
+        return;
+    }
+
+    const int tileSize  = 16, size = 256;
+    const int tileCount = std::max(1, (tileset.width / tileSize) * (tileset.height / tileSize));
+
+    std::mt19937     rng(11);
+    std::vector<int> tiles(size * size);
+    for (int& tile : tiles)
+        tile = static_cast<int>(rng() % tileCount);
+
+    ugfx::TileMap map(tileset, tileSize, tileSize, size, size);
+    map.SetTiles(tiles);
+
+    const ugfx::Vector2 world  = map.WorldSize();
+    const int           perRow = std::max(1, tileset.width / tileSize);
+    auto                viewAt = [&](int frame) {
+        float t = frame * 0.01f;
+        return ugfx::Rectangle{(world.x - cfg.width) * (0.5f + 0.5f * std::sin(t)),
+                               (world.y - cfg.height) * (0.5f + 0.5f * std::cos(t)), float(cfg.width),
+                               float(cfg.height)};
+    };
+
+    RunFrames(ctx, cfg, "tilemap/DrawTextureRegion", [&](int frame) {
+        ugfx::Rectangle view = viewAt(frame);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                int             tile = tiles[y * size + x];
+                ugfx::Rectangle src  = {float(tile % perRow * tileSize), float(tile / perRow * tileSize),
+                                        float(tileSize), float(tileSize)};
+                ctx.renderer->DrawTextureRegion(tileset, src, {x * tileSize - view.x, y * tileSize - view.y});
+            }
+        }
+    });
+
+    RunFrames(ctx, cfg, "tilemap/TileMap", [&](int frame) {
+        for (int i = 0; i < 8; ++i)
+            map.SetTile(rng() % size, rng() % size, static_cast<int>(rng() % tileCount));
+        map.Draw(*ctx.renderer, viewAt(frame));
+    });
+
+    ctx.renderer->UnloadTexture(tileset);
+}
+
+// 500k particles kept alive by a fountain emitter, updated and batched on the shared job system.
+void SceneParticles(BackendContext& ctx, const BenchConfig& cfg) {
+    const size_t         capacity = 500000;
+    ugfx::ParticleSystem particles(capacity);
+    ugfx::JobSystem&     jobs = ugfx::JobSystem::Shared();
+    particles.SetGravity({0.0f, 120.0f});
+
+    ugfx::ParticleEmitter fountain;
+    fountain.position   = {cfg.width * 0.5f, cfg.height * 0.8f};
+    fountain.extent     = {cfg.width * 0.4f, 4.0f};
+    fountain.spread     = 60.0f;
+    fountain.speedMin   = 100.0f;
+    fountain.speedMax   = 300.0f;
+    fountain.lifeMin    = 1.5f;
+    fountain.lifeMax    = 3.0f;
+    fountain.sizeStart  = 3.0f;
+    fountain.sizeEnd    = 1.0f;
+    fountain.colorStart = {255, 200, 80, 255};
+    fountain.colorEnd   = {255, 40, 20, 0};
+
+    double updateMs = 0.0;
+    RunFrames(ctx, cfg, "particles/ParticleSystem", [&](int) {
+        auto start = Clock::now();
+        particles.Emit(fountain, capacity - particles.Size());
+        particles.Update(1.0f / 60.0f, &jobs);
+        updateMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        particles.Draw(*ctx.renderer, {}, &jobs);
+    });
+    std::cout << "    emit + update: " << updateMs / cfg.frames << " ms/frame on " << jobs.WorkerCount() + 1
+              << " threads, " << particles.Size() << " alive\n";
+}
+
+// 400 labels per frame in sizes that change every frame. Sized default text goes through the distance field
+// atlas, so no size is ever rasterized twice. Then 40 wrapped, centred paragraphs through the layout cache.
+void SceneText(BackendContext& ctx, const BenchConfig& cfg) {
+    const int    count   = 400;
+    const char*  words[] = {"UniGraphics", "distance field", "Lexend 0123456789", "The quick brown fox"};
+    std::mt19937 rng(7);
+
+    std::vector<ugfx::Vector2> pos(count);
+    for (ugfx::Vector2& p : pos)
+        p = {float(rng() % cfg.width), float(rng() % cfg.height)};
+
+    RunFrames(ctx, cfg, "text/DrawText sized", [&](int frame) {
+        for (int i = 0; i < count; ++i) {
+            int size = 10 + (i + frame) % 50;
+            ctx.renderer->DrawText(words[i % 4], pos[i], size, {230, 230, 230, 255});
+        }
+    });
+
+    // Static wrapped paragraphs: after the first frame every layout is a cache hit
+    const std::string paragraph = "Layouts are cached by font, size, wrap width and text, so a label that does not "
+                                  "change is measured and broken into lines once.";
+    ugfx::TextOptions options;
+    options.wrapWidth = 240.0f;
+    options.align     = ugfx::TextAlign::Center;
+    RunFrames(ctx, cfg, "text/DrawText wrapped", [&](int) {
+        for (int i = 0; i < 40; ++i)
+            ctx.renderer->DrawText(ugfx::Font{}, paragraph, pos[i], 16.0f, options, {230, 230, 230, 255});
+    });
+
+    // Static labels in the default raster font: served from the text cache after the first frame, or rendered
+    // once up front as text objects
+    RunFrames(ctx, cfg, "text/DrawText labels", [&](int) {
+        for (int i = 0; i < 200; ++i)
+            ctx.renderer->DrawText(ugfx::Font{}, words[i % 4], pos[i], {230, 230, 230, 255});
+    });
+
+    ugfx::TextObject labels[4];
+    for (int i = 0; i < 4; ++i)
+        labels[i] = ctx.renderer->CreateTextObject(ugfx::Font{}, words[i], 0.0f, {230, 230, 230, 255});
+    RunFrames(ctx, cfg, "text/TextObject labels", [&](int) {
+        for (int i = 0; i < 200; ++i)
+            ctx.renderer->DrawTextObject(labels[i % 4], pos[i]);
+    });
+    for (ugfx::TextObject label : labels)
+        ctx.renderer->DestroyTextObject(label);
+
+    // HUD counters that change every frame, through the pre-baked bitmap font (baked by SDL builds of nob)
+    ugfx::Font hud = ctx.renderer->LoadBitmapFont(cfg.assetDir + "/Lexend32.fnt");
+    if (hud.id <= 0) {
+        std::cerr << "Missing bitmap font asset\n";
+        return;
+    }
+    std::string counter;
+    char        digits[32];
+    RunFrames(ctx, cfg, "text/bitmap counters", [&](int frame) {
+        for (int i = 0; i < 200; ++i) {
+            std::snprintf(digits, sizeof(digits), "%020llu", 987654321ull * (frame + 1) + i);
+            counter.assign(digits);
+            ctx.renderer->DrawText(hud, counter, pos[i], {255, 220, 120, 255});
+        }
+    });
+    ctx.renderer->UnloadFont(hud);
+}
+
+// 60 translucent full-screen layers, a fill-rate bound frame: at full resolution, then with dynamic resolution
+// aiming at 60 FPS.
+void SceneFillRate(BackendContext& ctx, const BenchConfig& cfg) {
+    const ugfx::Rectangle screen = {0.0f, 0.0f, float(cfg.width), float(cfg.height)};
+
+    auto draw = [&](int frame) {
+        for (int i = 0; i < 60; ++i)
+            ctx.renderer->DrawRectangle(screen, {static_cast<unsigned char>(frame + i * 4), 90, 160, 24});
+    };
+    RunFrames(ctx, cfg, "fillrate/full resolution", draw);
+
+    ugfx::DynamicResolution dynamic;
+    dynamic.enabled = true;
+    ctx.renderer->SetDynamicResolution(dynamic);
+    RunFrames(ctx, cfg, "fillrate/dynamic resolution", draw);
+    ctx.renderer->SetDynamicResolution({});
+}
+
+// A text field with a caret blinking every 500 ms, left alone for two seconds: rendered continuously, then in
+// event-driven mode where the only frames are the ones the blink timer asks for.
+void SceneIdle(BackendContext& ctx, const BenchConfig&) {
+    auto run = [&](const char* label, bool waitEvents) {
+        ctx.window->SetWaitEvents(waitEvents);
+        int        rendered = 0, polls = 0;
+        const auto start    = Clock::now();
+        while (Clock::now() - start < std::chrono::seconds(2) && !ctx.window->ShouldClose()) {
+            ctx.window->PollEvents();
+            ++polls;
+            if (!ctx.window->NeedsRedraw())
+                continue;
+
+            const auto elapsed =
+                std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+            ctx.window->RequestRedraw(static_cast<uint32_t>(500 - elapsed % 500));
+
+            ctx.renderer->BeginDrawing();
+            ctx.renderer->Clear({20, 20, 30, 255});
+            ctx.renderer->DrawText(ugfx::Font{}, "Type here", {40.0f, 40.0f}, {230, 230, 230, 255});
+            if ((elapsed / 500) % 2 == 0)
+                ctx.renderer->DrawRectangle({150.0f, 40.0f, 2.0f, 24.0f}, {230, 230, 230, 255});
+            ctx.renderer->EndDrawing();
+            ++rendered;
+        }
+        std::cout << label << ": " << rendered << " frames rendered, " << polls << " polls in 2 s\n";
+    };
+    run("idle/continuous", false);
+    run("idle/wait events", true);
+    ctx.window->SetWaitEvents(false);
+}
+
+// Pointer-driven drawing: mouse motion extends a trail, the burst action (left click, space or the bottom face
+// button) adds bursts, keys change the colour and the wheel the size, so the frame cost follows the input. Record
+// a session with --record and replay it for identical runs.
+void SceneInput(BackendContext& ctx, const BenchConfig& cfg) {
+    enum : ugfx::ActionId { kBurst };
+    ugfx::ActionMap actions;
+    actions.Bind(kBurst, ugfx::MouseButton::Left);
+    actions.Bind(kBurst, ugfx::Key::space);
+    actions.Bind(kBurst, ugfx::GamepadButton::FaceDown);
+
+    const size_t               maxTrail  = 8192;
+    const ugfx::Color          palette[] = {{230, 230, 230, 255}, {255, 120, 90, 255}, {120, 220, 140, 255}};
+    ugfx::Color                color     = palette[0];
+    ugfx::Vector2              pointer   = {cfg.width * 0.5f, cfg.height * 0.5f};
+    float                      radius    = 6.0f;
+    std::vector<ugfx::Vector2> trail;
+    ugfx::InputSnapshot        input;
+
+    // Events arrive through the bus during PollEvents, before the frame's draw callback
+    ugfx::EventBus&         bus  = ctx.input->GetEventBus();
+    ugfx::EventSubscription move = bus.Subscribe(ugfx::InputEvent::Type::MouseMove, [&](const ugfx::InputEvent& e) {
+        pointer = e.position;
+        trail.push_back(pointer);
+    });
+    ugfx::EventSubscription key = bus.Subscribe(ugfx::InputEvent::Type::KeyDown, [&](const ugfx::InputEvent& e) {
+        color = palette[static_cast<int>(e.key) % 3];
+    });
+
+    RunFrames(ctx, cfg, "input/pointer trail", [&](int) {
+        ctx.input->Snapshot(input);
+        actions.Resolve(input);
+
+        if (input.IsActionPressed(kBurst))
+            for (int i = 0; i < 64; ++i)
+                trail.push_back({pointer.x + std::cos(i * 0.1f) * i, pointer.y + std::sin(i * 0.1f) * i});
+        if (trail.size() > maxTrail)
+            trail.erase(trail.begin(), trail.end() - maxTrail);
+        radius = std::clamp(radius + input.pointer.wheel.y, 2.0f, 32.0f);
+
+        for (const ugfx::Vector2& p : trail)
+            ctx.renderer->DrawCircle(p, radius, color);
+        const ugfx::Vector2 cursor = ctx.input->ResamplePointer();  // drawn last, so sampled last
+        ctx.renderer->DrawRectangle({cursor.x - 2.0f, cursor.y - 2.0f, 4.0f, 4.0f}, {255, 255, 0, 255});
+    });
+    bus.Unsubscribe(move);
+    bus.Unsubscribe(key);
+    std::cout << "    " << trail.size() << " trail points\n";
+}
+
+struct SceneEntry {
+    const char* name;
+    void (*run)(BackendContext&, const BenchConfig&);
+};
+
+const SceneEntry kScenes[] = {
+    {"sprites", SceneSprites},
+    {"monochrome", SceneMonochrome},
+    {"single-texture", SceneSingleTexture},
+    {"sort", SceneSort},
+    {"culling", SceneCulling},
+    {"retained", SceneRetained},
+    {"tilemap", SceneTileMap},
+    {"particles", SceneParticles},
+    {"text", SceneText},
+    {"fillrate", SceneFillRate},
+    {"idle", SceneIdle},
+    {"input", SceneInput},
+};
+
+// ------------------- Main Program -------------------
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    cfg.assetDir = std::filesystem::current_path().string() + "/assets";
+
+    const char* sceneName  = nullptr;
+    int         positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            cfg.recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            cfg.replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--late-latch") == 0)
+            cfg.lateLatch = true;
+        else if (positional++ == 0)
+            sceneName = argv[i];
+        else
+            cfg.frames = std::max(1, std::atoi(argv[i]));
+    }
+
+    BackendContext ctx;
+    if (!InitBackend(ctx, cfg)) {
+        std::cerr << "Failed to initialize backend\n";
+        return -1;
+    }
+    ReportStartup(ctx);
+
+    for (const SceneEntry& scene : kScenes) {
+        if (sceneName && std::strcmp(sceneName, scene.name) != 0)
+            continue;
+        scene.run(ctx, cfg);
+    }
+
+    return 0;
+}
@@ -37,6 +37,11 @@ bool InitBackend(BackendContext& ctx, const std::string& title, int width, int h
     }
 
     ctx.window->SetTargetFPS(60);
+    ctx.window->SetFrameRatePolicy({.focused = 60, .unfocused = 10, .minimized = 0});
+    ctx.window->RegisterActivityCallback([](ugfx::WindowActivity, ugfx::WindowActivity current) {
+        const char* names[] = {"focused", "unfocused", "minimized"};
+        std::cout << "Window " << names[static_cast<int>(current)] << "\n";
+    });
     return true;
 }
 
@@ -91,49 +96,54 @@ int main() {
     ugfx::Texture texture = LoadTextureSafe(ctx.renderer, texturePath);
     ugfx::Font    font    = LoadFontSafe(ctx.renderer, fontPath, fontSize);
 
-    // Main loop
-    while (!ctx.window->ShouldClose()) {
-        ctx.window->PollEvents();
-        float dt = ctx.window->GetDeltaTime();
+    // Main loop: the simulation runs at a fixed 60 Hz, rendering blends the last two ticks
+    ugfx::Vector2 prevPos  = {rect.x, rect.y};
+    float         prevTime = totalTime;
 
-        // Clamp dt to avoid huge jumps after backend switch
-        dt = std::clamp(dt, 0.001f, 0.05f);
+    ugfx::FixedStepLoop* loop = nullptr;  // set below, for Stop from the update
 
+    ugfx::FixedStepCallbacks callbacks;
+    callbacks.update = [&](const ugfx::InputSnapshot& in, double step) {
+        const float dt = static_cast<float>(step);
+        prevPos        = {rect.x, rect.y};
+        prevTime       = totalTime;
         totalTime += dt;
-        rotation = 90.0f * totalTime;  // rotation in degrees
 
         // --- Input ---
         ugfx::Vector2 velocity{0, 0};
-        if (ctx.input->IsKeyDown(ugfx::Key::right))
+        if (in.IsKeyDown(ugfx::Key::right))
             velocity.x += speed;
-        if (ctx.input->IsKeyDown(ugfx::Key::left))
+        if (in.IsKeyDown(ugfx::Key::left))
             velocity.x -= speed;
-        if (ctx.input->IsKeyDown(ugfx::Key::up))
+        if (in.IsKeyDown(ugfx::Key::up))
             velocity.y -= speed;
-        if (ctx.input->IsKeyDown(ugfx::Key::down))
+        if (in.IsKeyDown(ugfx::Key::down))
             velocity.y += speed;
-        if (ctx.input->IsKeyDown(ugfx::Key::escape))
-            break;
-        if (ctx.input->IsKeyPressed(ugfx::Key::f))
+        if (in.IsKeyDown(ugfx::Key::escape))
+            loop->Stop();
+        if (in.IsKeyPressed(ugfx::Key::f))
             fontSize = std::min(fontSize + 2, 40);
-        if (ctx.input->IsKeyPressed(ugfx::Key::g))
+        if (in.IsKeyPressed(ugfx::Key::g))
             fontSize = std::max(fontSize - 2, 10);
 
         // --- Update ---
         rect.x += velocity.x * dt;
         rect.y += velocity.y * dt;
 
-        // Panels
-        ugfx::Rectangle shapesPanel   = {10, 10, 380, 300};
-        ugfx::Rectangle texturesPanel = {10, 320, 380, 300};
-        ugfx::Rectangle infoPanel     = {400, 10, 650, 610};
-
         // Clamp rectangle to shapesPanel
         rect.x = std::clamp(rect.x, 0.0f, (float) windowWidth);
         rect.y = std::clamp(rect.y, 0.0f, (float) windowHeight);
+    };
+    callbacks.render = [&](ugfx::IRenderer&, float alpha) {
+        const ugfx::Vector2 drawPos = {prevPos.x + (rect.x - prevPos.x) * alpha,
+                                       prevPos.y + (rect.y - prevPos.y) * alpha};
+        const float         time    = prevTime + (totalTime - prevTime) * alpha;
+        rotation                    = 90.0f * time;  // rotation in degrees
 
-        // --- Render ---
-        ctx.renderer->BeginDrawing();
+        // Panels
+        ugfx::Rectangle shapesPanel   = {10, 10, 380, 300};
+        ugfx::Rectangle texturesPanel = {10, 320, 380, 300};
+        ugfx::Rectangle infoPanel     = {400, 10, 650, 610};
 
         // Background gradient
         ugfx::Color bgTop    = {30, 30, 60, 255};
@@ -153,8 +163,8 @@ int main() {
 
         // --- Shapes inside shapesPanel ---
         ugfx::Vector2   shapesOffset = {shapesPanel.x + 10, shapesPanel.y + 10};
-        ugfx::Color     rectColor = {static_cast<unsigned char>(128 + 127 * std::sin(totalTime * 2.0f)), 165, 0, 255};
-        ugfx::Rectangle rectLocal = {rect.x + shapesOffset.x, rect.y + shapesOffset.y, rect.width, rect.height};
+        ugfx::Color     rectColor = {static_cast<unsigned char>(128 + 127 * std::sin(time * 2.0f)), 165, 0, 255};
+        ugfx::Rectangle rectLocal = {drawPos.x + shapesOffset.x, drawPos.y + shapesOffset.y, rect.width, rect.height};
         ctx.renderer->DrawRectangle(rectLocal, rectColor);
         ctx.renderer->DrawPixel({rectLocal.x + 25, rectLocal.y + 25}, {0, 255, 255, 255});
         ctx.renderer->DrawLine({shapesOffset.x + 10, shapesOffset.y + 60}, {shapesOffset.x + 110, shapesOffset.y + 110},
@@ -190,9 +200,11 @@ int main() {
         // Highlight around moving rectangle
         ctx.renderer->DrawRectangleLines({rectLocal.x - 2, rectLocal.y - 2, rectLocal.width + 4, rectLocal.height + 4},
                                          2.0f, {255, 255, 0, 200});
+    };
 
-        ctx.renderer->EndDrawing();
-    }
+    ugfx::FixedStepLoop fixedLoop(*ctx.backend, std::move(callbacks), {.tickRate = 60});
+    loop = &fixedLoop;
+    fixedLoop.Run();
 
     // Cleanup
     if (texture.id != -1)
@@ -8,6 +8,7 @@
 #define OBJ_DIR BUILD_DIR "obj/"
 #define SRC_DIR "src/"
 #define EXM_DIR "examples/"
+#define TOOL_DIR "tools/"
 
 #define VCPKG_PATH       "vcpkg_installed/x64-mingw-dynamic/"
 #define VCPKG_LIB_PATH   VCPKG_PATH "lib"
@@ -19,6 +20,8 @@
 #define IMGUI_PATH       "Vendor/imgui/"
 #define RAYLIB_PATH      "Vendor/raylib-5.5/"
 
+#define USE_HARFBUZZ     0  // shape text with HarfBuzz, needs the vcpkg "harfbuzz" feature
+
 #define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
 
 // -------------------- Globals --------------------
@@ -51,6 +54,9 @@ static bool compile_sources(StrVec *sources, const char **includes, size_t inclu
             cmd_append(&cmd, "-DUSE_RAYLIB");
         }
 
+        if (USE_HARFBUZZ)
+            cmd_append(&cmd, "-DUGFX_USE_HARFBUZZ", "-I", VCPKG_INC_PATH);
+
         for (size_t i = 0; i < include_count; i++)
             cmd_append(&cmd, "-I", includes[i]);
 
@@ -89,8 +95,8 @@ bool build_unigraphics_raylib() {
     return build_unigraphics_backend("Raylib", SRC_DIR "UniGraphics/backends/raylib/**/*.cpp", OBJ_DIR "UniGraphicsRaylib");
 }
 
-// -------------------- Main Build --------------------
-bool build_main(bool use_sdl) {
+// -------------------- Examples --------------------
+bool build_example(bool use_sdl, const char *source, const char *output) {
     const char *core_includes[] = {VCPKG_INC_PATH, SRC_DIR};
 
     const char *sdl_libs[] = {
@@ -108,7 +114,7 @@ bool build_main(bool use_sdl) {
     };
 
     def_cmd();
-    cmd_append(&cmd, EXM_DIR "Capabilities.cpp");
+    cmd_append(&cmd, source);
 
     for (size_t i = 0; i < ARRAY_SIZE(core_includes); i++)
         cmd_append(&cmd, "-I", core_includes[i]);
@@ -123,8 +129,64 @@ bool build_main(bool use_sdl) {
             cmd_append(&cmd, raylib_libs[i]);
     }
 
-    cmd_append(&cmd, "-o", BUILD_DIR "Examples");
+    if (USE_HARFBUZZ)
+        cmd_append(&cmd, "-lharfbuzz");
+
+    cmd_append(&cmd, "-o", output);
+
+    return cmd_run(&cmd);
+}
+
+bool build_main(bool use_sdl) {
+    return build_example(use_sdl, EXM_DIR "Capabilities.cpp", BUILD_DIR "Examples");
+}
+
+bool build_benchmarks(bool use_sdl) {
+    return build_example(use_sdl, EXM_DIR "Benchmarks.cpp", BUILD_DIR "Benchmarks");
+}
+
+// -------------------- Tools --------------------
+// The default font is embedded LZ4-compressed; the header is regenerated only when the TTF or the tool changed
+bool embed_default_font() {
+    const char *tool   = BUILD_DIR "EmbedFont";
+    const char *input  = EXM_DIR "assets/Lexend.ttf";
+    const char *output = SRC_DIR "UniGraphics/Lexend.h";
+
+    if (needs_rebuild1(tool, TOOL_DIR "EmbedFont.cpp")) {
+        def_cmd();
+        cmd_append(&cmd, TOOL_DIR "EmbedFont.cpp", "-o", tool);
+        if (!cmd_run(&cmd))
+            return false;
+    }
+
+    const char *inputs[] = {input, tool};
+    if (!needs_rebuild(output, inputs, ARRAY_SIZE(inputs)))
+        return true;
+
+    cmd_append(&cmd, tool, input, output, "Lexend_ttf");
+    return cmd_run(&cmd);
+}
+
+// The HUD bitmap font is baked from the embedded Lexend TTF into the example assets, only when the tool changed.
+// The tool rasterizes with SDL_ttf, so it runs on SDL builds only; the generated files are not tracked.
+bool bake_bitmap_font(int size) {
+    const char *tool   = BUILD_DIR "BakeBitmapFont";
+    const char *output = temp_sprintf(EXM_DIR "assets/Lexend%d", size);
+
+    const char *sources[] = {TOOL_DIR "BakeBitmapFont.cpp", SRC_DIR "UniGraphics/core/EmbeddedFont.cpp"};
+    if (needs_rebuild(tool, sources, ARRAY_SIZE(sources))) {
+        def_cmd();
+        cmd_append(&cmd, sources[0], sources[1], "-I", VCPKG_INC_PATH, "-I", SRC_DIR);
+        cmd_append(&cmd, "-L" VCPKG_LIB_PATH, "-lSDL2main", "-lSDL2", "-lSDL2_ttf", "-lSDL2_image");
+        cmd_append(&cmd, "-o", tool);
+        if (!cmd_run(&cmd))
+            return false;
+    }
+
+    if (!needs_rebuild1(temp_sprintf("%s.fnt", output), tool))
+        return true;
 
+    cmd_append(&cmd, tool, temp_sprintf("%d", size), output);
     return cmd_run(&cmd);
 }
 
@@ -137,14 +199,18 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    if (!embed_default_font()) return 1;
+
     bool use_sdl = false;
     if (use_sdl) {
         if (!build_unigraphics_sdl()) return 1;
+        if (!bake_bitmap_font(32)) return 1;
     } else {
         if (!build_unigraphics_raylib()) return 1;
     }
 
     // if (!build_main(use_sdl)) return 1;
+    // if (!build_benchmarks(use_sdl)) return 1;
 
     return 0;
 }
@@ -7,9 +7,9 @@
 namespace ugfx::raylib {
 
     RaylibBackend::RaylibBackend() {
-        m_Window   = std::make_unique<RaylibWindow>();
-        m_Input    = std::make_unique<RaylibInput>();
-        m_Renderer = std::make_unique<RaylibRenderer>();
+        m_Input    = std::make_unique<RaylibInput>(&m_FrameStats);
+        m_Window   = std::make_unique<RaylibWindow>(m_Input.get(), &m_FrameStats);
+        m_Renderer = std::make_unique<RaylibRenderer>(&m_FrameStats);
     }
 
     RaylibBackend::~RaylibBackend() {
@@ -0,0 +1,41 @@
+#include "RaylibGlyphSource.h"
+
+#include <cstring>
+
+namespace ugfx::raylib {
+
+    bool RaylibGlyphSource::Rasterize(uint32_t codepoint, GlyphBitmap& out) {
+        int        cp    = static_cast<int>(codepoint);
+        GlyphInfo* glyph = LoadFontData(m_FontData.data(), static_cast<int>(m_FontData.size()), m_BaseSize, &cp, 1,
+                                        FONT_DEFAULT);
+        if (!glyph)
+            return false;
+        if (!glyph->image.data && glyph->advanceX == 0) {
+            UnloadFontData(glyph, 1);
+            return false;  // not in the font, leave it to a fallback
+        }
+
+        // FONT_DEFAULT images are 8-bit grayscale coverage, offsets measured from the top of the line
+        const Image& image = glyph->image;
+        out.advance        = static_cast<float>(glyph->advanceX > 0 ? glyph->advanceX : image.width);
+        out.offsetX        = glyph->offsetX;
+        out.offsetY        = glyph->offsetY;
+        if (image.data && image.width > 0 && image.height > 0) {
+            out.width  = image.width;
+            out.height = image.height;
+            out.coverage.resize(static_cast<size_t>(image.width) * image.height);
+            std::memcpy(out.coverage.data(), image.data, out.coverage.size());
+        }
+        UnloadFontData(glyph, 1);
+        return true;
+    }
+
+    float RaylibFontMetrics::Advance(uint32_t codepoint) {
+        if (!m_Font.glyphs)
+            return 0.0f;
+        const int index   = GetGlyphIndex(m_Font, static_cast<int>(codepoint));
+        const int advance = m_Font.glyphs[index].advanceX;
+        return (advance > 0 ? static_cast<float>(advance) : m_Font.recs[index].width) + kSpacing;
+    }
+
+}  // namespace ugfx::raylib
@@ -1,6 +1,10 @@
 #include "RaylibInput.h"
 
+#include <algorithm>
+
 namespace ugfx::raylib {
+
+
     void* RaylibInput::GetHandle() const {
         return nullptr;
     }
@@ -11,7 +15,121 @@ namespace ugfx::raylib {
     void RaylibInput::BeginFrame() {
     }
 
-    void RaylibInput::RegisterEventCallback(EventCallback callback) {
+    void RaylibInput::EndFrame() {
+        CollectEvents();
+        m_Events.Publish();
+        if (m_Stats)
+            m_Events.Record(*m_Stats);
+        m_Bus.Dispatch(m_Events.Events());
+    }
+
+    // raylib polls the platform in EndDrawing and keeps only per-frame state and small queues, so events are
+    // rebuilt from those: ordered by type rather than arrival, stamped when collected, without key repeats.
+    void RaylibInput::CollectEvents() {
+        InputEvent e;
+        e.timestamp = SteadyNanoseconds();
+
+        m_Keys.BeginFrame();
+        for (int key = ::GetKeyPressed(); key != 0; key = ::GetKeyPressed()) {
+            e.type = InputEvent::Type::KeyDown;
+            e.key  = static_cast<Key>(key);
+            m_Events.Push(e);
+            m_Keys.Press(e.key);
+            if (std::find(m_HeldKeys.begin(), m_HeldKeys.end(), key) == m_HeldKeys.end())
+                m_HeldKeys.push_back(key);
+        }
+        std::erase_if(m_HeldKeys, [&](int key) {
+            if (::IsKeyDown(key))
+                return false;
+            e.type = InputEvent::Type::KeyUp;
+            e.key  = static_cast<Key>(key);
+            m_Events.Push(e);
+            m_Keys.Release(e.key);
+            return true;
+        });
+
+        e.type = InputEvent::Type::Text;
+        for (int cp = ::GetCharPressed(); cp != 0; cp = ::GetCharPressed()) {
+            e.codepoint = static_cast<uint32_t>(cp);
+            m_Events.Push(e);
+        }
+
+        const ::Vector2 mouse = ::GetMousePosition();
+        e.position            = {mouse.x, mouse.y};
+        const ::Vector2 delta = ::GetMouseDelta();
+        if (delta.x != 0.0f || delta.y != 0.0f) {
+            e.type  = InputEvent::Type::MouseMove;
+            e.delta = {delta.x, delta.y};
+            m_Events.Push(e);
+        }
+        for (int b = MOUSE_BUTTON_LEFT; b <= MOUSE_BUTTON_EXTRA; ++b) {
+            e.button = static_cast<MouseButton>(b);  // same order as raylib's first five buttons
+            if (::IsMouseButtonPressed(b)) {
+                e.type = InputEvent::Type::MouseDown;
+                m_Events.Push(e);
+            }
+            if (::IsMouseButtonReleased(b)) {
+                e.type = InputEvent::Type::MouseUp;
+                m_Events.Push(e);
+            }
+        }
+        const ::Vector2 wheel = ::GetMouseWheelMoveV();
+        if (wheel.x != 0.0f || wheel.y != 0.0f) {
+            e.type  = InputEvent::Type::Wheel;
+            e.delta = {wheel.x, wheel.y};
+            m_Events.Push(e);
+        }
+
+        if (!::IsWindowReady())
+            return;
+        e.type = InputEvent::Type::Window;
+        if (::IsWindowResized()) {
+            e.window   = WindowAction::Resized;
+            e.position = {static_cast<float>(::GetScreenWidth()), static_cast<float>(::GetScreenHeight())};
+            m_Events.Push(e);
+        }
+        if (::IsWindowFocused() != m_Focused) {
+            m_Focused = !m_Focused;
+            e.window  = m_Focused ? WindowAction::FocusGained : WindowAction::FocusLost;
+            m_Events.Push(e);
+        }
+        if (::IsWindowMinimized() != m_Minimized) {
+            m_Minimized = !m_Minimized;
+            e.window    = m_Minimized ? WindowAction::Minimized : WindowAction::Restored;
+            m_Events.Push(e);
+        }
+    }
+
+    void RaylibInput::Snapshot(InputSnapshot& out) const {
+        out.timestamp = SteadyNanoseconds();
+        out.keys      = m_Keys;
+
+        PointerState& pointer = out.pointer;
+        pointer               = PointerState();
+        pointer.position      = GetMousePosition();
+        pointer.delta         = GetMouseDelta();
+        pointer.wheel         = GetMouseWheel();
+        for (int b = MOUSE_BUTTON_LEFT; b <= MOUSE_BUTTON_EXTRA; ++b) {
+            const uint8_t bit = static_cast<uint8_t>(1u << b);
+            pointer.down     |= ::IsMouseButtonDown(b) ? bit : 0;
+            pointer.pressed  |= ::IsMouseButtonPressed(b) ? bit : 0;
+            pointer.released |= ::IsMouseButtonReleased(b) ? bit : 0;
+        }
+
+        for (int i = 0; i < InputSnapshot::kGamepads; ++i) {
+            GamepadSnapshot& snap = out.gamepads[i];
+            snap                  = GamepadSnapshot();
+            if (!::IsGamepadAvailable(i))
+                continue;
+            snap.connected = true;
+            for (size_t a = 0; a < snap.axes.size(); ++a)
+                snap.axes[a] = GetGamepadAxis(i, static_cast<ugfx::GamepadAxis>(a));
+            for (size_t b = 1; b < snap.down.size(); ++b) {
+                snap.down[b]     = ::IsGamepadButtonDown(i, static_cast<int>(b));
+                snap.pressed[b]  = ::IsGamepadButtonPressed(i, static_cast<int>(b));
+                snap.released[b] = ::IsGamepadButtonReleased(i, static_cast<int>(b));
+            }
+        }
     }
 
     bool RaylibInput::IsKeyDown(ugfx::Key key) const {
@@ -30,6 +148,61 @@ namespace ugfx::raylib {
         return ::IsKeyUp(MapKey(key));
     }
 
+    ugfx::Vector2 RaylibInput::GetMousePosition() const {
+        const ::Vector2 p = ::GetMousePosition();
+        return {p.x, p.y};
+    }
+
+    ugfx::Vector2 RaylibInput::GetMouseDelta() const {
+        const ::Vector2 d = ::GetMouseDelta();
+        return {d.x, d.y};
+    }
+
+    ugfx::Vector2 RaylibInput::GetMouseWheel() const {
+        const ::Vector2 w = ::GetMouseWheelMoveV();
+        return {w.x, w.y};
+    }
+
+    // ugfx::MouseButton follows raylib's order
+    bool RaylibInput::IsMouseButtonDown(ugfx::MouseButton button) const {
+        return ::IsMouseButtonDown(static_cast<int>(button));
+    }
+
+    bool RaylibInput::IsMouseButtonPressed(ugfx::MouseButton button) const {
+        return ::IsMouseButtonPressed(static_cast<int>(button));
+    }
+
+    bool RaylibInput::IsMouseButtonReleased(ugfx::MouseButton button) const {
+        return ::IsMouseButtonReleased(static_cast<int>(button));
+    }
+
+    bool RaylibInput::IsGamepadAvailable(int gamepad) const {
+        return ::IsGamepadAvailable(gamepad);
+    }
+
+    float RaylibInput::GetGamepadAxis(int gamepad, ugfx::GamepadAxis axis) const {
+        if (!::IsGamepadAvailable(gamepad))
+            return 0.0f;
+        const float value = ::GetGamepadAxisMovement(gamepad, static_cast<int>(axis));
+        // raylib reports released triggers as -1
+        if (axis == ugfx::GamepadAxis::LeftTrigger || axis == ugfx::GamepadAxis::RightTrigger)
+            return (value + 1.0f) * 0.5f;
+        return value;
+    }
+
+    // ugfx::GamepadButton follows raylib's order as well
+    bool RaylibInput::IsGamepadButtonDown(int gamepad, ugfx::GamepadButton button) const {
+        return ::IsGamepadButtonDown(gamepad, static_cast<int>(button));
+    }
+
+    bool RaylibInput::IsGamepadButtonPressed(int gamepad, ugfx::GamepadButton button) const {
+        return ::IsGamepadButtonPressed(gamepad, static_cast<int>(button));
+    }
+
+    bool RaylibInput::IsGamepadButtonReleased(int gamepad, ugfx::GamepadButton button) const {
+        return ::IsGamepadButtonReleased(gamepad, static_cast<int>(button));
+    }
+
     KeyboardKey RaylibInput::MapKey(ugfx::Key key) const {
         return static_cast<KeyboardKey>(static_cast<int>(key));
     }
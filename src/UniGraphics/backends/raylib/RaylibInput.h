@@ -2,28 +2,58 @@
 
 #include <raylib.h>
 
+#include <vector>
+
 #include "UniGraphics.h"
 
 namespace ugfx::raylib {
 
     class RaylibInput : public IInput {
        public:
-        RaylibInput()           = default;
+        explicit RaylibInput(FrameStats* stats = nullptr) : m_Stats(stats) {}
         ~RaylibInput() override = default;
 
         void* GetHandle() const override;
 
         void ProcessEvents(void* event) override;
         void BeginFrame() override;
-        void RegisterEventCallback(EventCallback callback) override;
+        void EndFrame() override;
+
+        std::span<const InputEvent> GetEvents() const override { return m_Events.Events(); }
+        EventBus&                   GetEventBus() override { return m_Bus; }
+        void                        Snapshot(InputSnapshot& out) const override;
 
         bool IsKeyDown(ugfx::Key key) const override;
         bool IsKeyPressed(ugfx::Key key) const override;
         bool IsKeyReleased(ugfx::Key key) const override;
         bool IsKeyUp(ugfx::Key key) const override;
 
+        ugfx::Vector2 GetMousePosition() const override;
+        ugfx::Vector2 GetMouseDelta() const override;
+        ugfx::Vector2 GetMouseWheel() const override;
+        bool          IsMouseButtonDown(ugfx::MouseButton button) const override;
+        bool          IsMouseButtonPressed(ugfx::MouseButton button) const override;
+        bool          IsMouseButtonReleased(ugfx::MouseButton button) const override;
+        ugfx::Vector2 ResamplePointer() override { return GetMousePosition(); }  // raylib samples only in EndDrawing
+        void          SetRawMotion(bool enabled) override {}  // raylib only reports the frame's total motion
+
+        bool  IsGamepadAvailable(int gamepad) const override;
+        float GetGamepadAxis(int gamepad, ugfx::GamepadAxis axis) const override;
+        bool  IsGamepadButtonDown(int gamepad, ugfx::GamepadButton button) const override;
+        bool  IsGamepadButtonPressed(int gamepad, ugfx::GamepadButton button) const override;
+        bool  IsGamepadButtonReleased(int gamepad, ugfx::GamepadButton button) const override;
+
        private:
         KeyboardKey MapKey(ugfx::Key key) const;
+        void        CollectEvents();
+
+        InputEventQueue  m_Events;
+        EventBus         m_Bus;
+        FrameStats*      m_Stats = nullptr;
+        std::vector<int> m_HeldKeys;  // raylib queues presses only, releases are found by checking these
+        KeyboardState    m_Keys;      // the same presses and releases, for snapshots
+        bool             m_Focused   = true;
+        bool             m_Minimized = false;
     };
 
 }  // namespace ugfx::raylib
\ No newline at end of file
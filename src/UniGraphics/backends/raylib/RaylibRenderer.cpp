@@ -1,36 +1,135 @@
 #include "RaylibRenderer.h"
 
+#include <rlgl.h>
+
+#include <algorithm>
 #include <functional>
 #include <iostream>
 
 #include "RaylibConverter.h"
+#include "core/DrawBounds.h"
+#include "core/EmbeddedFont.h"
+#include "core/HarfBuzzGlyphSource.h"
+#include "core/SpriteBatch.h"
+#include "core/Utf8.h"
 
 namespace ugfx::raylib {
 
-    RaylibRenderer::RaylibRenderer() {
+    static constexpr int    kSdfBaseSize     = 48;        // distance field glyphs are rasterized once at this size
+    static constexpr float  kLineSpacing     = 2.0f;      // DrawTextEx's default extra space between lines
+    static constexpr size_t kTextCacheBudget = 16u << 20;  // bytes of cached text vertices
+    static constexpr Color  kWhite           = {255, 255, 255, 255};
+
+    // Smoothstep over one screen pixel around the 0.5 iso-line keeps edges sharp at any scale
+    static const char* kSdfFragmentShader = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main() {
+    float d     = texture(texture0, fragTexCoord).r;
+    float w     = max(fwidth(d), 1e-4) * 0.5;
+    float alpha = smoothstep(0.5 - w, 0.5 + w, d);
+    finalColor  = vec4(fragColor.rgb, fragColor.a * alpha) * colDiffuse;
+})";
+
+    // Submits a triangle list through rlgl in chunks that fit the default render batch
+    static void SubmitTriangles(unsigned int texId, std::span<const Vertex2D> vertices, std::span<const int> indices) {
+        const size_t count = indices.empty() ? vertices.size() : indices.size();
+        const size_t chunk = 3 * 1024;  // whole triangles, well below the default batch size
+
+        for (size_t start = 0; start + 2 < count; start += chunk) {
+            size_t end = std::min(start + chunk, count - count % 3);
+
+            rlCheckRenderBatchLimit(static_cast<int>(end - start));
+            rlSetTexture(texId);
+            rlBegin(RL_TRIANGLES);
+            for (size_t i = start; i < end; ++i) {
+                const Vertex2D& v = indices.empty() ? vertices[i] : vertices[indices[i]];
+                rlColor4ub(v.color.r, v.color.g, v.color.b, v.color.a);
+                rlTexCoord2f(v.texCoord.x, v.texCoord.y);
+                rlVertex2f(v.position.x, v.position.y);
+            }
+            rlEnd();
+        }
+        rlSetTexture(0);
+    }
+
+    RaylibRenderer::RaylibRenderer(FrameStats* stats) : Renderer(stats), m_TextCache(kTextCacheBudget, {}) {
     }
 
     RaylibRenderer::~RaylibRenderer() {
         ReleaseAllResources();
+        if (m_DefaultSdf && m_DefaultSdf->texture.id != 0)
+            ::UnloadTexture(m_DefaultSdf->texture);
+        if (m_SdfShader.id != 0)
+            ::UnloadShader(m_SdfShader);
+        if (m_SceneTarget.id != 0)
+            ::UnloadRenderTexture(m_SceneTarget);
     }
 
-    void RaylibRenderer::BeginDrawing() {
+    void RaylibRenderer::BeginFrame() {
         ::BeginDrawing();
+
+        m_SceneScale = RenderScale();
+        if (m_SceneScale < 1.0f) {
+            const int width = ::GetScreenWidth(), height = ::GetScreenHeight();
+            if (m_SceneTarget.texture.width != width || m_SceneTarget.texture.height != height) {
+                if (m_SceneTarget.id != 0)
+                    ::UnloadRenderTexture(m_SceneTarget);
+                m_SceneTarget = ::LoadRenderTexture(width, height);
+                ::SetTextureFilter(m_SceneTarget.texture, TEXTURE_FILTER_BILINEAR);
+            }
+            if (m_SceneTarget.id == 0)
+                m_SceneScale = 1.0f;
+        }
+        m_Stats->renderScale = m_SceneScale;
+        if (m_SceneScale >= 1.0f)
+            return;
+
+        ::BeginTextureMode(m_SceneTarget);
+        rlPushMatrix();
+        rlScalef(m_SceneScale, m_SceneScale, 1.0f);
+        if (m_ClipEnabled)
+            ApplyClipRect(&m_ClipRect);  // texture mode starts without the scissor, and it has to be scaled
     }
 
-    void RaylibRenderer::EndDrawing() {
+    void RaylibRenderer::EndFrame() {
+        if (m_SceneScale < 1.0f) {
+            if (m_ClipEnabled)
+                ::EndScissorMode();
+            rlPopMatrix();
+            ::EndTextureMode();
+
+            // Render textures are stored bottom-up: the frame's top-left corner sits at the top of the texture
+            const float       width  = static_cast<float>(m_SceneTarget.texture.width);
+            const float       height = static_cast<float>(m_SceneTarget.texture.height);
+            const ::Rectangle src    = {0.0f, height * (1.0f - m_SceneScale), width * m_SceneScale,
+                                        -height * m_SceneScale};
+            rlDisableColorBlend();  // copy, whatever the frame left in alpha or as blend mode
+            ::DrawTexturePro(m_SceneTarget.texture, src, {0.0f, 0.0f, width, height}, {0.0f, 0.0f}, 0.0f,
+                             ToRaylib(kWhite));
+            rlDrawRenderBatchActive();
+            rlEnableColorBlend();
+        }
         ::EndDrawing();
     }
 
-    void RaylibRenderer::Clear(ugfx::Color color) {
+    void RaylibRenderer::RenderClear(ugfx::Color color) {
         ::ClearBackground(ToRaylib(color));
     }
 
+    Rectangle RaylibRenderer::GetViewport() const {
+        return {0.0f, 0.0f, static_cast<float>(::GetScreenWidth()), static_cast<float>(::GetScreenHeight())};
+    }
+
     void RaylibRenderer::ReleaseAllResources() {
-        m_FontManager.Clear([](::Font* f) {
-            ::UnloadFont(*f);
-            delete f;
-        });
+        ReleaseBitmapFonts();
+        m_TextCache.Clear();
+        m_Stats->textCacheBytes = 0;
+        m_TextObjects.Clear([](TextEntry* e) { delete e; });
+        m_FontManager.Clear([this](FontEntry* f) { DestroyFont(f); });
         m_TextureManager.Clear([](::Texture2D* t) {
             ::UnloadTexture(*t);
             delete t;
@@ -42,27 +141,65 @@ namespace ugfx::raylib {
         return nullptr;
     }
 
-    void RaylibRenderer::DrawPixel(ugfx::Vector2 pos, ugfx::Color color) {
+    void RaylibRenderer::ApplyBlendMode(BlendMode mode) {
+        // Shadowed here: rlgl skips repeated preset modes itself, but flushes its batch on every BLEND_CUSTOM call
+        if (mode == m_BlendMode)
+            return;
+        m_BlendMode = mode;
+
+        switch (mode) {
+            case BlendMode::Additive:
+                ::BeginBlendMode(BLEND_ADDITIVE);
+                break;
+            case BlendMode::Multiply:
+                ::BeginBlendMode(BLEND_MULTIPLIED);
+                break;
+            case BlendMode::None:
+                rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+                ::BeginBlendMode(BLEND_CUSTOM);
+                break;
+            case BlendMode::Alpha:
+            default:
+                ::EndBlendMode();
+                break;
+        }
+    }
+
+    void RaylibRenderer::ApplyClipRect(const Rectangle* rect) {
+        if (m_ClipEnabled)
+            ::EndScissorMode();
+        m_ClipEnabled = rect != nullptr;
+        if (!rect)
+            return;
+        m_ClipRect = *rect;
+
+        // The scissor works in target pixels, outside the modelview scale
+        const float s = m_SceneScale;
+        ::BeginScissorMode(static_cast<int>(rect->x * s), static_cast<int>(rect->y * s),
+                           static_cast<int>(rect->width * s), static_cast<int>(rect->height * s));
+    }
+
+    void RaylibRenderer::RenderPixel(ugfx::Vector2 pos, ugfx::Color color) {
         ::DrawPixelV(ToRaylib(pos), ToRaylib(color));
     }
 
-    void RaylibRenderer::DrawLine(ugfx::Vector2 start, ugfx::Vector2 end, float thickness, ugfx::Color color) {
+    void RaylibRenderer::RenderLine(ugfx::Vector2 start, ugfx::Vector2 end, float thickness, ugfx::Color color) {
         ::DrawLineEx(ToRaylib(start), ToRaylib(end), thickness, ToRaylib(color));
     }
 
-    void RaylibRenderer::DrawRectangle(ugfx::Rectangle rect, ugfx::Color color) {
+    void RaylibRenderer::RenderRectangle(ugfx::Rectangle rect, ugfx::Color color) {
         ::DrawRectangleRec(ToRaylib(rect), ToRaylib(color));
     }
 
-    void RaylibRenderer::DrawRectangleLines(ugfx::Rectangle rect, float thickness, ugfx::Color color) {
+    void RaylibRenderer::RenderRectangleLines(ugfx::Rectangle rect, float thickness, ugfx::Color color) {
         ::DrawRectangleLinesEx(ToRaylib(rect), thickness, ToRaylib(color));
     }
 
-    void RaylibRenderer::DrawCircle(ugfx::Vector2 center, float radius, ugfx::Color color) {
+    void RaylibRenderer::RenderCircle(ugfx::Vector2 center, float radius, ugfx::Color color) {
         ::DrawCircleV(ToRaylib(center), radius, ToRaylib(color));
     }
 
-    void RaylibRenderer::DrawTriangle(ugfx::Vector2 v1, ugfx::Vector2 v2, ugfx::Vector2 v3, ugfx::Color color) {
+    void RaylibRenderer::RenderTriangle(ugfx::Vector2 v1, ugfx::Vector2 v2, ugfx::Vector2 v3, ugfx::Color color) {
         ::DrawTriangle(ToRaylib(v1), ToRaylib(v2), ToRaylib(v3), ToRaylib(color));
     }
 
@@ -86,7 +223,7 @@ namespace ugfx::raylib {
         }
     }
 
-    void RaylibRenderer::DrawTexture(Texture tex, Vector2 pos, Color tint) {
+    void RaylibRenderer::RenderTexture(Texture tex, Vector2 pos, Color tint) {
         if (tex.id == -1)
             return;
 
@@ -96,7 +233,7 @@ namespace ugfx::raylib {
         ::DrawTextureV(*texture, ToRaylib(pos), ToRaylib(tint));
     }
 
-    void RaylibRenderer::DrawTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) {
+    void RaylibRenderer::RenderTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) {
         if (tex.id == -1)
             return;
 
@@ -109,8 +246,8 @@ namespace ugfx::raylib {
         ::DrawTextureRec(*texture, rSrc, rDst, ToRaylib(tint));
     }
 
-    void RaylibRenderer::DrawTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin,
-                                           float rotation, Flip flip, Color tint) {
+    void RaylibRenderer::RenderTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin,
+                                             float rotation, Flip flip, Color tint) {
         if (texture.id == -1)
             return;
         ::Texture2D* tex = m_TextureManager.Get(texture.id);
@@ -134,8 +271,8 @@ namespace ugfx::raylib {
         ::DrawTexturePro(*tex, srcRect, dstRect, rOrigin, rotation, ToRaylib(tint));
     }
 
-    void RaylibRenderer::DrawTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
-                                       Color tint) {
+    void RaylibRenderer::RenderTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale,
+                                         Flip flip, Color tint) {
         if (tex.id == -1)
             return;
 
@@ -161,33 +298,317 @@ namespace ugfx::raylib {
         ::DrawTexturePro(*texture, rSrc, rDst, rOrigin, rotation, ToRaylib(tint));
     }
 
+    void RaylibRenderer::RenderGeometry(Texture tex, std::span<const Vertex2D> vertices, std::span<const int> indices) {
+        if (vertices.empty())
+            return;
+
+        ::Texture2D* texture = m_TextureManager.Get(tex.id);
+        SubmitTriangles(texture ? texture->id : rlGetTextureIdDefault(), vertices, indices);
+    }
+
     Font RaylibRenderer::LoadFont(const std::string& path, int size) {
-        ::Font* f = new ::Font(LoadFontEx(path.c_str(), size, nullptr, 0));
-        if (f->texture.id == 0) {
+        ::Font f = LoadFontEx(path.c_str(), size, nullptr, 0);
+        if (f.texture.id == 0) {
             std::cerr << "Failed to load font: " << path << std::endl;
-            delete f;
             return Font{-1};
         }
-        int id = m_FontManager.Add(f);
+        int id = m_FontManager.Add(new FontEntry{f, nullptr, std::make_unique<RaylibFontMetrics>(f)});
+        return Font{id};
+    }
+
+    // Shapes with HarfBuzz when built with it, otherwise rasterizes code point by code point through stb_truetype
+    static std::unique_ptr<IGlyphSource> OpenSdfSource(const std::string& path) {
+        int            size = 0;
+        unsigned char* data = LoadFileData(path.c_str(), &size);
+        if (!data) {
+            std::cerr << "Failed to load SDF font: " << path << std::endl;
+            return nullptr;
+        }
+        std::vector<unsigned char> bytes(data, data + size);
+        UnloadFileData(data);
+
+        if (HarfBuzzAvailable())
+            return CreateHarfBuzzGlyphSource(std::move(bytes), kSdfBaseSize);
+        return std::make_unique<RaylibGlyphSource>(std::move(bytes), kSdfBaseSize);
+    }
+
+    Font RaylibRenderer::LoadSdfFont(const std::string& path) {
+        std::unique_ptr<IGlyphSource> source = OpenSdfSource(path);
+        if (!source)
+            return Font{-1};
+
+        auto sdf = std::make_unique<SdfFont>(std::move(source));
+        int  id  = m_FontManager.Add(new FontEntry{{}, std::move(sdf), nullptr});
         return Font{id};
     }
 
+    // The embedded font is only decompressed and parsed once text actually uses it
+    RaylibRenderer::SdfFont* RaylibRenderer::DefaultSdfFont() {
+        if (m_DefaultSdf)
+            return m_DefaultSdf.get();
+
+        const std::span<const uint8_t> data = DefaultFontData();
+        if (data.empty()) {
+            std::cerr << "Failed to load embedded SDF font" << std::endl;
+            return nullptr;
+        }
+        std::vector<unsigned char> bytes(data.begin(), data.end());
+        std::unique_ptr<IGlyphSource> source;
+        if (HarfBuzzAvailable())
+            source = CreateHarfBuzzGlyphSource(std::move(bytes), kSdfBaseSize);
+        else
+            source = std::make_unique<RaylibGlyphSource>(std::move(bytes), kSdfBaseSize);
+        m_DefaultSdf = std::make_unique<SdfFont>(std::move(source));
+        return m_DefaultSdf.get();
+    }
+
+    bool RaylibRenderer::AddFallbackFont(Font font, const std::string& path) {
+        FontEntry* f   = m_FontManager.Get(font.id);
+        SdfFont*   sdf = f ? f->sdf.get() : DefaultSdfFont();
+        if (!sdf) {
+            std::cerr << "AddFallbackFont: only distance field fonts take fallbacks" << std::endl;
+            return false;
+        }
+        std::unique_ptr<IGlyphSource> source = OpenSdfSource(path);
+        if (!source)
+            return false;
+        sdf->atlas.AddFallback(std::move(source));
+        return true;
+    }
+
     void RaylibRenderer::UnloadFont(Font font) {
-        ::Font* f = m_FontManager.Get(font.id);
+        if (UnloadBitmapFont(font))
+            return;
+        FontEntry* f = m_FontManager.Get(font.id);
         if (f) {
-            ::UnloadFont(*f);
-            delete f;
+            m_TextCache.EraseFont(font.id);
+            m_Stats->textCacheBytes = m_TextCache.Bytes();
+            DestroyFont(f);
             m_FontManager.Remove(font.id);
         }
     }
 
-    void RaylibRenderer::DrawText(Font font, const std::string& text, Vector2 pos, Color color) {
-        auto f = resolveFont(font);
-        ::DrawTextEx(f, text.c_str(), ToRaylib(pos), f.baseSize, 1.0f, ToRaylib(color));
+    void RaylibRenderer::DestroyFont(FontEntry* font) {
+        if (font->raster.texture.id != 0)
+            ::UnloadFont(font->raster);
+        if (font->sdf && font->sdf->texture.id != 0)
+            ::UnloadTexture(font->sdf->texture);
+        delete font;
+    }
+
+    void RaylibRenderer::RenderText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) {
+        FontEntry* f = m_FontManager.Get(font.id);
+        if (f && f->sdf) {
+            RenderSdfText(*f->sdf, text, pos, fontSize > 0.0f ? fontSize : f->sdf->atlas.BaseSize(), color);
+            return;
+        }
+        if (!f && fontSize > 0.0f) {
+            if (SdfFont* sdf = DefaultSdfFont())
+                RenderSdfText(*sdf, text, pos, fontSize, color);
+            return;
+        }
+
+        // Distance field text already reuses atlas glyphs and shaped runs, so only raster text goes through the
+        // cache. Entries are tinted when drawn, so one serves every color.
+        const int   key   = f ? font.id : 0;
+        TextEntry*  entry = m_TextCache.Find(key, fontSize, kWhite, text);
+        if (entry) {
+            ++m_Stats->textCacheHits;
+        } else {
+            ++m_Stats->textCacheMisses;
+            TextEntry baked;
+            if (!BakeText(font, text, fontSize, baked))
+                return;
+            const size_t bytes = baked.vertices.capacity() * sizeof(Vertex2D) + sizeof(TextEntry);
+            entry = &m_TextCache.Insert(key, fontSize, kWhite, text, std::move(baked), bytes);
+            m_Stats->textCacheBytes = m_TextCache.Bytes();
+        }
+        DrawTextEntry(*entry, pos, color);
+    }
+
+    // Mirrors the font selection in RenderText. Raster quads are placed the way DrawTextEx places them: raylib's
+    // default font is a small bitmap atlas scaled on the GPU, and spacing scales with the size so RaylibFontMetrics
+    // can measure in base units.
+    bool RaylibRenderer::BakeText(Font font, const std::string& text, float fontSize, TextEntry& out) {
+        FontEntry* f   = m_FontManager.Get(font.id);
+        SdfFont*   sdf = f ? f->sdf.get() : fontSize > 0.0f ? DefaultSdfFont() : nullptr;
+        if (sdf) {
+            out.font     = f ? font.id : -1;
+            out.fontSize = fontSize > 0.0f ? fontSize : static_cast<float>(sdf->atlas.BaseSize());
+            out.sdf      = true;
+            sdf->atlas.BuildQuads(text, {0.0f, 0.0f}, out.fontSize, kWhite, out.vertices);
+            out.atlasHeight = sdf->atlas.Height();
+            out.bounds      = BoundsOfVertices(out.vertices);
+            return true;
+        }
+
+        const ::Font raster = f ? f->raster : GetFontDefault();
+        if (raster.texture.id == 0 || raster.baseSize <= 0)
+            return false;
+
+        const float size    = fontSize > 0.0f ? fontSize : static_cast<float>(raster.baseSize);
+        const float scale   = size / static_cast<float>(raster.baseSize);
+        const float spacing = RaylibFontMetrics::kSpacing * scale;
+        const float pad     = static_cast<float>(raster.glyphPadding);
+        const float invW    = 1.0f / static_cast<float>(raster.texture.width);
+        const float invH    = 1.0f / static_cast<float>(raster.texture.height);
+
+        out.font     = f ? font.id : 0;
+        out.fontSize = size;
+        float x = 0.0f, y = 0.0f;
+        for (size_t i = 0; i < text.size();) {
+            const uint32_t codepoint = DecodeUtf8(text, i);
+            if (codepoint == '\n') {
+                x = 0.0f;
+                y += size + kLineSpacing;
+                continue;
+            }
+
+            const int          index = ::GetGlyphIndex(raster, static_cast<int>(codepoint));
+            const ::Rectangle& rec   = raster.recs[index];
+            const ::GlyphInfo& glyph = raster.glyphs[index];
+            if (codepoint != ' ' && codepoint != '\t') {
+                const float x0 = x + (static_cast<float>(glyph.offsetX) - pad) * scale;
+                const float y0 = y + (static_cast<float>(glyph.offsetY) - pad) * scale;
+                const float x1 = x0 + (rec.width + 2.0f * pad) * scale;
+                const float y1 = y0 + (rec.height + 2.0f * pad) * scale;
+                const float u0 = (rec.x - pad) * invW, u1 = (rec.x + rec.width + pad) * invW;
+                const float v0 = (rec.y - pad) * invH, v1 = (rec.y + rec.height + pad) * invH;
+                out.vertices.push_back({{x0, y0}, kWhite, {u0, v0}});
+                out.vertices.push_back({{x1, y0}, kWhite, {u1, v0}});
+                out.vertices.push_back({{x0, y1}, kWhite, {u0, v1}});
+                out.vertices.push_back({{x1, y1}, kWhite, {u1, v1}});
+            }
+            x += (glyph.advanceX == 0 ? rec.width : static_cast<float>(glyph.advanceX)) * scale + spacing;
+        }
+        out.bounds = BoundsOfVertices(out.vertices);
+        return true;
+    }
+
+    void RaylibRenderer::DrawTextEntry(TextEntry& entry, Vector2 pos, Color tint) {
+        const size_t quads = entry.vertices.size() / 4;
+        if (quads == 0)
+            return;
+
+        FontEntry*   f       = m_FontManager.Get(entry.font);
+        SdfFont*     sdf     = !entry.sdf ? nullptr : entry.font == -1 ? DefaultSdfFont() : f ? f->sdf.get() : nullptr;
+        unsigned int texture = 0;
+        if (sdf) {
+            if (!LoadSdfShader())
+                return;
+            UploadAtlas(*sdf);
+            if (const int height = sdf->atlas.Height(); height != entry.atlasHeight) {
+                const float rescale = static_cast<float>(entry.atlasHeight) / static_cast<float>(height);
+                for (Vertex2D& v : entry.vertices)
+                    v.texCoord.y *= rescale;
+                entry.atlasHeight = height;
+            }
+            texture = sdf->texture.id;
+        } else if (!entry.sdf) {
+            // 0 was baked with raylib's default font; an unloaded font leaves UVs into a texture that is gone
+            texture = entry.font == 0 ? GetFontDefault().texture.id : f ? f->raster.texture.id : 0;
+        }
+        if (texture == 0)
+            return;
+
+        m_TextVertices.resize(entry.vertices.size());
+        for (size_t i = 0; i < entry.vertices.size(); ++i) {
+            const Vertex2D& v = entry.vertices[i];
+            m_TextVertices[i] = {{v.position.x + pos.x, v.position.y + pos.y}, tint, v.texCoord};
+        }
+        BuildQuadIndices(quads, m_TextIndices);
+
+        const std::span<const int> indices(m_TextIndices.data(), quads * 6);
+        if (sdf) {
+            ::BeginShaderMode(m_SdfShader);
+            SubmitTriangles(texture, m_TextVertices, indices);
+            ::EndShaderMode();
+        } else {
+            SubmitTriangles(texture, m_TextVertices, indices);
+        }
+    }
+
+    // ------------------- Text objects -------------------
+
+    TextObject RaylibRenderer::CreateTextObject(Font font, const std::string& text, float fontSize, Color color) {
+        auto entry = std::make_unique<TextEntry>();
+        if (!BakeText(font, text, fontSize, *entry))
+            return {};
+        entry->tint            = color;
+        const Rectangle bounds = entry->bounds;
+        return {m_TextObjects.Add(entry.release()), bounds};
+    }
+
+    void RaylibRenderer::RenderTextObject(TextObject object, Vector2 pos) {
+        if (TextEntry* entry = m_TextObjects.Get(object.id))
+            DrawTextEntry(*entry, pos, entry->tint);
+    }
+
+    void RaylibRenderer::DestroyTextObject(TextObject object) {
+        if (TextEntry* entry = m_TextObjects.Get(object.id)) {
+            delete entry;
+            m_TextObjects.Remove(object.id);
+        }
+    }
+
+    void RaylibRenderer::SetTextCacheBudget(size_t bytes) {
+        m_TextCache.SetBudget(bytes);
+        m_Stats->textCacheBytes = m_TextCache.Bytes();
+    }
+
+    IGlyphMetrics* RaylibRenderer::GetGlyphMetrics(Font font, float fontSize) {
+        // Mirrors the font selection in RenderText
+        if (FontEntry* f = m_FontManager.Get(font.id))
+            return f->sdf ? static_cast<IGlyphMetrics*>(&f->sdf->atlas) : f->metrics.get();
+        if (fontSize > 0.0f) {
+            SdfFont* sdf = DefaultSdfFont();
+            return sdf ? &sdf->atlas : nullptr;
+        }
+        if (!m_DefaultMetrics)
+            m_DefaultMetrics = std::make_unique<RaylibFontMetrics>(GetFontDefault());
+        return m_DefaultMetrics.get();
     }
 
-    void RaylibRenderer::DrawText(const std::string& text, Vector2 pos, int fontSize, Color color) {
-        ::DrawTextEx(defaultFont(), text.c_str(), ToRaylib(pos), fontSize, 1.0f, ToRaylib(color));
+    bool RaylibRenderer::LoadSdfShader() {
+        if (m_SdfShader.id == 0) {
+            m_SdfShader = LoadShaderFromMemory(nullptr, kSdfFragmentShader);
+            if (!IsShaderReady(m_SdfShader))
+                std::cerr << "Failed to compile SDF text shader" << std::endl;
+        }
+        return IsShaderReady(m_SdfShader);
+    }
+
+    void RaylibRenderer::UploadAtlas(SdfFont& font) {
+        const GlyphAtlas& atlas = font.atlas;
+        if (font.texture.id != 0 && font.version == atlas.Version())
+            return;
+
+        if (font.texture.id != 0 && font.texture.height == atlas.Height()) {
+            ::UpdateTexture(font.texture, atlas.Pixels().data());
+        } else {
+            if (font.texture.id != 0)
+                ::UnloadTexture(font.texture);
+            Image image  = {const_cast<uint8_t*>(atlas.Pixels().data()), atlas.Width(), atlas.Height(), 1,
+                            PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+            font.texture = ::LoadTextureFromImage(image);
+            ::SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+        }
+        font.version = atlas.Version();
+    }
+
+    void RaylibRenderer::RenderSdfText(SdfFont& font, const std::string& text, Vector2 pos, float fontSize,
+                                       Color color) {
+        m_TextVertices.clear();
+        const size_t quads = font.atlas.BuildQuads(text, pos, fontSize, color, m_TextVertices);
+        if (quads == 0 || !LoadSdfShader())
+            return;
+
+        UploadAtlas(font);  // after BuildQuads, which may have added glyphs
+        BuildQuadIndices(quads, m_TextIndices);
+
+        ::BeginShaderMode(m_SdfShader);
+        SubmitTriangles(font.texture.id, m_TextVertices, std::span<const int>(m_TextIndices.data(), quads * 6));
+        ::EndShaderMode();
     }
 
 }  // namespace ugfx::raylib
\ No newline at end of file
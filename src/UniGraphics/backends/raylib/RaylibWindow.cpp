@@ -1,8 +1,11 @@
 #include "RaylibWindow.h"
 
+#include <chrono>
+#include <utility>
+
 namespace ugfx::raylib {
 
-    RaylibWindow::RaylibWindow() {
+    RaylibWindow::RaylibWindow(IInput* input, FrameStats* stats) : m_Input(input), m_Stats(stats) {
     }
 
     RaylibWindow::~RaylibWindow() {
@@ -18,15 +21,20 @@ namespace ugfx::raylib {
             rlFlags |= FLAG_WINDOW_UNDECORATED;
         if (HasFlag(flags, WindowFlags::Resizable))
             rlFlags |= FLAG_WINDOW_RESIZABLE;
-        if (HasFlag(flags, WindowFlags::VSync))
-            rlFlags |= FLAG_VSYNC_HINT;
+        if (HasFlag(flags, WindowFlags::VSync | WindowFlags::AdaptiveVSync))
+            rlFlags |= FLAG_VSYNC_HINT;  // raylib exposes no adaptive swap interval
         if (HasFlag(flags, WindowFlags::Hidden))
             rlFlags |= FLAG_WINDOW_HIDDEN;
         if (HasFlag(flags, WindowFlags::AlwaysOnTop))
             rlFlags |= FLAG_WINDOW_TOPMOST;
 
+        // InitWindow also creates the GL context, so this covers the renderer too
+        const auto start = std::chrono::steady_clock::now();
         SetConfigFlags(rlFlags);
         InitWindow(width, height, title.c_str());
+        m_MainThread = std::this_thread::get_id();
+        if (m_Stats)
+            m_Stats->startup.windowCreate = MillisecondsSince(start);
         return IsWindowReady();
     }
 
@@ -43,7 +51,79 @@ namespace ugfx::raylib {
     }
 
     void RaylibWindow::PollEvents() {
-        // Raylib handles events internally; no-op unless custom events needed
+        // raylib polls input itself in EndDrawing; events and activity are read from its state once per frame
+        if (m_Input) {
+            m_Input->BeginFrame();
+            m_Input->EndFrame();
+        }
+        UpdateActivity();
+        while (m_Governor.Stopped() && !WindowShouldClose()) {
+            WaitTime(0.1);
+            PollInputEvents();
+            UpdateActivity();
+        }
+
+        // In wait mode, decide whether the next EndDrawing may block for events. raylib has no wait timeout, so
+        // a pending timer keeps frames running until it is due.
+        if (!m_WaitEvents)
+            return;
+        m_Redraw.Update(Now(), false);  // requests made since the last frame render in this one
+        if (m_Redraw.Animating() || m_Redraw.HasTimer())
+            DisableEventWaiting();
+        else
+            EnableEventWaiting();
+    }
+
+    void RaylibWindow::UpdateActivity() {
+        if (!IsWindowReady())
+            return;
+        WindowActivity activity = WindowActivity::Unfocused;
+        if (IsWindowMinimized() || IsWindowHidden())
+            activity = WindowActivity::Minimized;
+        else if (IsWindowFocused())
+            activity = WindowActivity::Focused;
+
+        if (m_Governor.Update(activity, m_Stats)) {
+            ApplyFrameRate();
+            RequestRedraw();
+        }
+    }
+
+    void RaylibWindow::ApplyFrameRate() {
+        const int fps = m_Governor.TargetFps();
+        ::SetTargetFPS(fps > 0 ? fps : 0);
+        if (m_Stats)
+            m_Stats->targetFps = fps > 0 ? fps : 0;
+    }
+
+    void RaylibWindow::SetFrameRatePolicy(const FrameRatePolicy& policy) {
+        m_Governor.SetPolicy(policy);
+        ApplyFrameRate();
+    }
+
+    void RaylibWindow::RegisterActivityCallback(ActivityCallback callback) {
+        m_Governor.AddCallback(std::move(callback));
+    }
+
+    void RaylibWindow::SetWaitEvents(bool enabled) {
+        m_WaitEvents = enabled;
+        if (!enabled)
+            DisableEventWaiting();
+    }
+
+    void RaylibWindow::RequestRedraw(uint32_t delayMs) {
+        if (delayMs == 0)
+            m_Redraw.Request();
+        else
+            m_Redraw.RequestAt(Now() + delayMs);
+        if (std::this_thread::get_id() == m_MainThread)
+            DisableEventWaiting();  // the next EndDrawing must not block
+    }
+
+    void RaylibWindow::BeginAnimation() {
+        m_Redraw.BeginAnimation();
+        if (std::this_thread::get_id() == m_MainThread)
+            DisableEventWaiting();
     }
 
     void RaylibWindow::Shutdown() {
@@ -53,7 +133,17 @@ namespace ugfx::raylib {
     }
 
     void RaylibWindow::SetTargetFPS(int fps) {
-        ::SetTargetFPS(fps);
+        m_Governor.SetBaseFps(fps);
+        ApplyFrameRate();
+    }
+
+    void RaylibWindow::SetVSync(VSyncMode mode) {
+        if (!IsWindowReady())
+            return;
+        if (mode == VSyncMode::Off)
+            ClearWindowState(FLAG_VSYNC_HINT);
+        else
+            SetWindowState(FLAG_VSYNC_HINT);
     }
 
     float RaylibWindow::GetDeltaTime() const {
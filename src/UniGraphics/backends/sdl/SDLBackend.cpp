@@ -4,6 +4,7 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <chrono>
 #include <iostream>
 
 #include "SDLInput.h"
@@ -12,44 +13,26 @@
 
 namespace ugfx::sdl {
 
+    // Only SDL itself comes up here. The window and renderer wait for IWindow::Create, so nothing is built before
+    // the size is known, and SDL_image / SDL_ttf for their first use in the renderer.
     SDLBackend::SDLBackend() {
+        const auto start = std::chrono::steady_clock::now();
         if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
             std::cerr << "SDL_Init failed: " << SDL_GetError() << std::endl;
             return;
         }
-        if (IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) == 0) {
-            std::cerr << "IMG_Init failed: " << IMG_GetError() << std::endl;
-            return;
-        }
-        if (TTF_Init() != 0) {
-            std::cerr << "TTF_Init failed: " << TTF_GetError() << std::endl;
-            return;
-        }
+        m_FrameStats.startup.backendInit = MillisecondsSince(start);
 
         SDL_version version;
         SDL_GetVersion(&version);
         std::cout << "SDL Version: " << (int) version.major << "." << (int) version.minor << "." << (int) version.patch
                   << std::endl;
 
-        m_Input = std::make_unique<SDLInput>();
+        m_Input = std::make_unique<SDLInput>(&m_FrameStats);
 
-        m_Window = std::make_unique<SDLWindow>(m_Input.get());
-        if (!m_Window) {
-            std::cerr << "Failed to create SDLWindow" << std::endl;
-            return;
-        }
-
-        // // Create renderer only if window is valid
-        auto* sdlWindow = static_cast<SDLWindow*>(m_Window.get());
-        if (!sdlWindow->GetWindow()) {
-            std::cerr << "SDLWindow has no valid window" << std::endl;
-            return;
-        }
-        m_Renderer = std::make_unique<SDLRenderer>(sdlWindow->GetWindow());
-        if (!m_Renderer) {
-            std::cerr << "Failed to create SDLRenderer" << std::endl;
-            return;
-        }
+        auto renderer = std::make_unique<SDLRenderer>(&m_FrameStats);
+        m_Window      = std::make_unique<SDLWindow>(m_Input.get(), renderer.get(), &m_FrameStats);
+        m_Renderer    = std::move(renderer);
     }
 
     SDLBackend::~SDLBackend() {
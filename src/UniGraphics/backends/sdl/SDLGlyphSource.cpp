@@ -0,0 +1,79 @@
+#include "SDLGlyphSource.h"
+
+#include <algorithm>
+
+namespace ugfx::sdl {
+
+    SDLGlyphSource::~SDLGlyphSource() {
+        if (m_Font)
+            TTF_CloseFont(m_Font);
+    }
+
+    float SDLGlyphSource::LineHeight() const {
+        return static_cast<float>(TTF_FontLineSkip(m_Font));
+    }
+
+    float SDLGlyphSource::Kerning(uint32_t left, uint32_t right) {
+        return static_cast<float>(TTF_GetFontKerningSizeGlyphs32(m_Font, left, right));
+    }
+
+    bool SDLGlyphSource::Rasterize(uint32_t codepoint, GlyphBitmap& out) {
+        int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+        if (!TTF_GlyphIsProvided32(m_Font, codepoint) ||
+            TTF_GlyphMetrics32(m_Font, codepoint, &minX, &maxX, &minY, &maxY, &advance) != 0)
+            return false;
+        out.advance = static_cast<float>(advance);
+
+        // The surface spans the whole line height with the pen at its left edge, shifted for negative bearings
+        SDL_Surface* surf = TTF_RenderGlyph32_Blended(m_Font, codepoint, {255, 255, 255, 255});
+        if (!surf)
+            return true;  // nothing to draw, e.g. a space
+
+        // ARGB8888: coverage is the alpha byte. Trim the blank border so the atlas only stores ink.
+        auto alpha = [surf](int x, int y) {
+            const auto* row = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(surf->pixels) +
+                                                                 y * surf->pitch);
+            return static_cast<uint8_t>(row[x] >> 24);
+        };
+        int x0 = surf->w, y0 = surf->h, x1 = -1, y1 = -1;
+        for (int y = 0; y < surf->h; ++y) {
+            for (int x = 0; x < surf->w; ++x) {
+                if (alpha(x, y)) {
+                    x0 = std::min(x0, x);
+                    x1 = std::max(x1, x);
+                    y0 = std::min(y0, y);
+                    y1 = std::max(y1, y);
+                }
+            }
+        }
+
+        if (x1 >= x0) {
+            out.width   = x1 - x0 + 1;
+            out.height  = y1 - y0 + 1;
+            out.offsetX = std::min(0, minX) + x0;
+            out.offsetY = y0;
+            out.coverage.resize(static_cast<size_t>(out.width) * out.height);
+            for (int y = 0; y < out.height; ++y)
+                for (int x = 0; x < out.width; ++x)
+                    out.coverage[y * out.width + x] = alpha(x0 + x, y0 + y);
+        }
+        SDL_FreeSurface(surf);
+        return true;
+    }
+
+    float SDLFontMetrics::LineHeight() const {
+        return static_cast<float>(TTF_FontLineSkip(m_Font));
+    }
+
+    float SDLFontMetrics::Advance(uint32_t codepoint) {
+        int advance = 0;
+        if (TTF_GlyphMetrics32(m_Font, codepoint, nullptr, nullptr, nullptr, nullptr, &advance) != 0)
+            return 0.0f;
+        return static_cast<float>(advance);
+    }
+
+    float SDLFontMetrics::Kerning(uint32_t left, uint32_t right) {
+        return static_cast<float>(TTF_GetFontKerningSizeGlyphs32(m_Font, left, right));
+    }
+
+}  // namespace ugfx::sdl
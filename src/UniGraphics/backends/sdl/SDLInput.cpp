@@ -3,76 +3,387 @@
 #include <SDL2/SDL.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+#include "core/Utf8.h"
 
 namespace ugfx::sdl {
 
-    SDLInput::SDLInput() {
-        m_CurrentDown.reset();
-        m_PressedThisFrame.reset();
-        m_ReleasedThisFrame.reset();
+    SDLInput::SDLInput(FrameStats* stats) : m_Stats(stats) {
     }
 
-    SDLInput::~SDLInput() = default;
+    SDLInput::~SDLInput() {
+        for (Gamepad& pad : m_Gamepads)
+            if (pad.controller)
+                SDL_GameControllerClose(pad.controller);
+    }
 
     void* SDLInput::GetHandle() const {
-        return static_cast<void*>(const_cast<SDL_Event*>(&m_LastEvent));
+        return nullptr;  // events are available typed through GetEvents and the event bus
     }
 
     void SDLInput::ProcessEvents(void* event) {
         auto sdlEvent = static_cast<SDL_Event*>(event);
-        m_LastEvent   = *sdlEvent;
+        Translate(*sdlEvent);
 
         switch (sdlEvent->type) {
-            case SDL_KEYDOWN: {
-                if (!sdlEvent->key.repeat) {
-                    SDL_Scancode sc = sdlEvent->key.keysym.scancode;
-                    if (!m_CurrentDown.test(sc)) {
-                        m_CurrentDown.set(sc);
-                        m_PressedThisFrame.set(sc);
-                    }
-                }
-            } break;
-            case SDL_KEYUP: {
-                SDL_Scancode sc = sdlEvent->key.keysym.scancode;
-                m_CurrentDown.reset(sc);
-                m_ReleasedThisFrame.set(sc);
-            } break;
+            case SDL_KEYDOWN:
+                if (!sdlEvent->key.repeat)
+                    m_Keys.Press(ToKey(sdlEvent->key.keysym.scancode));
+                break;
+            case SDL_KEYUP:
+                m_Keys.Release(ToKey(sdlEvent->key.keysym.scancode));
+                break;
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP:
+            case SDL_CONTROLLERDEVICEADDED:
+            case SDL_CONTROLLERDEVICEREMOVED:
+                HandleGamepadEvent(*sdlEvent);
+                break;
             default:
                 break;
         }
+    }
 
-        for (const auto& cb : m_EventCallbacks) {
-            cb(event);
+    void SDLInput::BeginFrame() {
+        m_Keys.BeginFrame();
+        m_Pointer.BeginFrame();
+        for (Gamepad& pad : m_Gamepads) {
+            pad.pressed.reset();
+            pad.released.reset();
         }
     }
 
-    void SDLInput::BeginFrame() {
-        // m_CurrentDown.reset();
-        m_PressedThisFrame.reset();
-        m_ReleasedThisFrame.reset();
+    void SDLInput::EndFrame() {
+        m_Events.FlushMotion();
+        m_Events.Publish();
+        if (m_Stats)
+            m_Events.Record(*m_Stats);
+        m_Bus.Dispatch(m_Events.Events());
     }
 
-    void SDLInput::RegisterEventCallback(EventCallback callback) {
-        m_EventCallbacks.push_back(callback);
+    void SDLInput::Translate(const SDL_Event& event) {
+        // SDL stamps events in milliseconds on its own clock; carry the age over to the steady clock
+        const uint64_t now   = SteadyNanoseconds();
+        const Uint32   ticks = SDL_GetTicks();
+        const uint64_t age   = event.common.timestamp <= ticks ? (ticks - event.common.timestamp) * 1000000ull : 0;
+
+        InputEvent e;
+        e.timestamp = now > age ? now - age : now;
+
+        auto button = [](Uint8 b) {
+            switch (b) {
+                case SDL_BUTTON_RIGHT:
+                    return MouseButton::Right;
+                case SDL_BUTTON_MIDDLE:
+                    return MouseButton::Middle;
+                case SDL_BUTTON_X1:
+                    return MouseButton::Side;
+                case SDL_BUTTON_X2:
+                    return MouseButton::Extra;
+                default:
+                    return MouseButton::Left;
+            }
+        };
+
+        switch (event.type) {
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+                e.type   = event.type == SDL_KEYDOWN ? InputEvent::Type::KeyDown : InputEvent::Type::KeyUp;
+                e.key    = ToKey(event.key.keysym.scancode);
+                e.repeat = event.key.repeat != 0;
+                m_Events.Push(e);
+                break;
+            case SDL_TEXTINPUT: {
+                e.type                = InputEvent::Type::Text;
+                const std::string_view text(event.text.text);
+                for (size_t i = 0; i < text.size();) {
+                    e.codepoint = DecodeUtf8(text, i);
+                    m_Events.Push(e);
+                }
+            } break;
+            case SDL_MOUSEMOTION:
+                e.type     = InputEvent::Type::MouseMove;
+                e.position = {static_cast<float>(event.motion.x), static_cast<float>(event.motion.y)};
+                e.delta    = {static_cast<float>(event.motion.xrel), static_cast<float>(event.motion.yrel)};
+                m_Pointer.Apply(e);
+                m_Events.Push(e);
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP: {
+                const bool down = event.type == SDL_MOUSEBUTTONDOWN;
+                e.type          = down ? InputEvent::Type::MouseDown : InputEvent::Type::MouseUp;
+                e.button        = button(event.button.button);
+                e.position      = {static_cast<float>(event.button.x), static_cast<float>(event.button.y)};
+                m_Pointer.Apply(e);
+                m_Events.Push(e);
+            } break;
+            case SDL_MOUSEWHEEL: {
+                const float flip = event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED ? -1.0f : 1.0f;
+                e.type           = InputEvent::Type::Wheel;
+                e.delta          = {event.wheel.preciseX * flip, event.wheel.preciseY * flip};
+                m_Pointer.Apply(e);
+                m_Events.Push(e);
+            } break;
+            // SDL_QUIT follows the last window's SDL_WINDOWEVENT_CLOSE and also covers quits without one (Ctrl-C, the
+            // app menu), so it alone reports Close, once, as raylib does
+            case SDL_QUIT:
+                e.type   = InputEvent::Type::Window;
+                e.window = WindowAction::Close;
+                m_Events.Push(e);
+                break;
+            case SDL_WINDOWEVENT:
+                e.type = InputEvent::Type::Window;
+                switch (event.window.event) {
+                    case SDL_WINDOWEVENT_SIZE_CHANGED:
+                        e.window   = WindowAction::Resized;
+                        e.position = {static_cast<float>(event.window.data1), static_cast<float>(event.window.data2)};
+                        break;
+                    case SDL_WINDOWEVENT_FOCUS_GAINED:
+                        e.window = WindowAction::FocusGained;
+                        break;
+                    case SDL_WINDOWEVENT_FOCUS_LOST:
+                        e.window = WindowAction::FocusLost;
+                        break;
+                    case SDL_WINDOWEVENT_MINIMIZED:
+                        e.window = WindowAction::Minimized;
+                        break;
+                    case SDL_WINDOWEVENT_RESTORED:
+                        e.window = WindowAction::Restored;
+                        break;
+                    case SDL_WINDOWEVENT_SHOWN:
+                        e.window = WindowAction::Shown;
+                        break;
+                    case SDL_WINDOWEVENT_HIDDEN:
+                        e.window = WindowAction::Hidden;
+                        break;
+                    default:
+                        return;
+                }
+                m_Events.Push(e);
+                break;
+            default:
+                break;
+        }
     }
 
     bool SDLInput::IsKeyDown(Key key) const {
-        return m_CurrentDown.test(MapKey(key));
+        return KeyboardState::Test(m_Keys.down, key);
     }
 
     bool SDLInput::IsKeyPressed(Key key) const {
-        return m_PressedThisFrame.test(MapKey(key));
+        return KeyboardState::Test(m_Keys.pressed, key);
     }
 
     bool SDLInput::IsKeyReleased(Key key) const {
-        return m_ReleasedThisFrame.test(MapKey(key));
+        return KeyboardState::Test(m_Keys.released, key);
     }
 
     bool SDLInput::IsKeyUp(Key key) const {
-        return !m_CurrentDown.test(MapKey(key));
+        return !KeyboardState::Test(m_Keys.down, key);
+    }
+
+    bool SDLInput::IsMouseButtonDown(MouseButton button) const {
+        return PointerState::Test(m_Pointer.down, button);
+    }
+
+    bool SDLInput::IsMouseButtonPressed(MouseButton button) const {
+        return PointerState::Test(m_Pointer.pressed, button);
+    }
+
+    bool SDLInput::IsMouseButtonReleased(MouseButton button) const {
+        return PointerState::Test(m_Pointer.released, button);
+    }
+
+    Vector2 SDLInput::ResamplePointer() {
+        SDL_PumpEvents();  // updates SDL's mouse state; the pumped events are handled by the next PollEvents
+        int x = 0, y = 0;
+        SDL_GetMouseState(&x, &y);
+        if (m_Stats)
+            m_Stats->pointerTimestamp = SteadyNanoseconds();
+        return {static_cast<float>(x), static_cast<float>(y)};
+    }
+
+    void SDLInput::SetRawMotion(bool enabled) {
+        m_Events.SetCoalesceMotion(!enabled);
+    }
+
+    // SDL_INIT_GAMECONTROLLER is deferred to here because it enumerates HID devices, which can take a noticeable
+    // part of startup. Controllers already attached are opened now, later ones from their device events.
+    void SDLInput::InitGamepads() const {
+        if (m_GamepadsInit)
+            return;
+        m_GamepadsInit   = true;
+        const auto start = std::chrono::steady_clock::now();
+        if (SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) != 0) {
+            std::cerr << "SDL_InitSubSystem(GAMECONTROLLER) failed: " << SDL_GetError() << std::endl;
+            return;
+        }
+        for (int i = 0; i < SDL_NumJoysticks(); ++i)
+            OpenGamepad(i);
+        if (m_Stats)
+            m_Stats->startup.gamepadInit += MillisecondsSince(start);
     }
 
-    SDL_Scancode SDLInput::MapKey(Key key) const {
+    void SDLInput::OpenGamepad(int deviceIndex) const {
+        if (!SDL_IsGameController(deviceIndex))
+            return;
+        SDL_GameController* controller = SDL_GameControllerOpen(deviceIndex);
+        if (!controller)
+            return;
+        const SDL_JoystickID id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller));
+        if (FindGamepadById(id)) {
+            SDL_GameControllerClose(controller);  // the added event of a pad opened by InitGamepads
+            return;
+        }
+        for (Gamepad& pad : m_Gamepads) {
+            if (!pad.controller) {
+                pad.controller = controller;
+                pad.id         = id;
+                return;
+            }
+        }
+        SDL_GameControllerClose(controller);  // all slots taken
+    }
+
+    SDLInput::Gamepad* SDLInput::FindGamepadById(SDL_JoystickID id) const {
+        for (Gamepad& pad : m_Gamepads)
+            if (pad.controller && pad.id == id)
+                return &pad;
+        return nullptr;
+    }
+
+    const SDLInput::Gamepad* SDLInput::FindGamepad(int slot) const {
+        InitGamepads();
+        if (slot < 0 || slot >= kMaxGamepads || !m_Gamepads[slot].controller)
+            return nullptr;
+        return &m_Gamepads[slot];
+    }
+
+    static GamepadButton ToGamepadButton(Uint8 button) {
+        switch (button) {
+            case SDL_CONTROLLER_BUTTON_A:
+                return GamepadButton::FaceDown;
+            case SDL_CONTROLLER_BUTTON_B:
+                return GamepadButton::FaceRight;
+            case SDL_CONTROLLER_BUTTON_X:
+                return GamepadButton::FaceLeft;
+            case SDL_CONTROLLER_BUTTON_Y:
+                return GamepadButton::FaceUp;
+            case SDL_CONTROLLER_BUTTON_BACK:
+                return GamepadButton::Back;
+            case SDL_CONTROLLER_BUTTON_GUIDE:
+                return GamepadButton::Guide;
+            case SDL_CONTROLLER_BUTTON_START:
+                return GamepadButton::Start;
+            case SDL_CONTROLLER_BUTTON_LEFTSTICK:
+                return GamepadButton::LeftThumb;
+            case SDL_CONTROLLER_BUTTON_RIGHTSTICK:
+                return GamepadButton::RightThumb;
+            case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:
+                return GamepadButton::LeftShoulder;
+            case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER:
+                return GamepadButton::RightShoulder;
+            case SDL_CONTROLLER_BUTTON_DPAD_UP:
+                return GamepadButton::DpadUp;
+            case SDL_CONTROLLER_BUTTON_DPAD_DOWN:
+                return GamepadButton::DpadDown;
+            case SDL_CONTROLLER_BUTTON_DPAD_LEFT:
+                return GamepadButton::DpadLeft;
+            case SDL_CONTROLLER_BUTTON_DPAD_RIGHT:
+                return GamepadButton::DpadRight;
+            default:
+                return GamepadButton::Unknown;
+        }
+    }
+
+    void SDLInput::HandleGamepadEvent(const SDL_Event& event) {
+        switch (event.type) {
+            case SDL_CONTROLLERDEVICEADDED:
+                OpenGamepad(event.cdevice.which);
+                break;
+            case SDL_CONTROLLERDEVICEREMOVED:
+                if (Gamepad* pad = FindGamepadById(event.cdevice.which)) {
+                    SDL_GameControllerClose(pad->controller);
+                    *pad = Gamepad();
+                }
+                break;
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP: {
+                Gamepad*     pad = FindGamepadById(event.cbutton.which);
+                const size_t b   = static_cast<size_t>(ToGamepadButton(event.cbutton.button));
+                if (!pad || b == 0)
+                    break;
+                if (event.type == SDL_CONTROLLERBUTTONDOWN) {
+                    if (!pad->down.test(b))
+                        pad->pressed.set(b);
+                    pad->down.set(b);
+                } else {
+                    pad->down.reset(b);
+                    pad->released.set(b);
+                }
+            } break;
+            default:
+                break;
+        }
+    }
+
+    bool SDLInput::IsGamepadAvailable(int gamepad) const {
+        return FindGamepad(gamepad) != nullptr;
+    }
+
+    static float ReadAxis(SDL_GameController* controller, GamepadAxis axis) {
+        static constexpr SDL_GameControllerAxis axes[] = {
+            SDL_CONTROLLER_AXIS_LEFTX,  SDL_CONTROLLER_AXIS_LEFTY,       SDL_CONTROLLER_AXIS_RIGHTX,
+            SDL_CONTROLLER_AXIS_RIGHTY, SDL_CONTROLLER_AXIS_TRIGGERLEFT, SDL_CONTROLLER_AXIS_TRIGGERRIGHT,
+        };
+        const Sint16 value = SDL_GameControllerGetAxis(controller, axes[static_cast<size_t>(axis)]);
+        return std::max(value / 32767.0f, -1.0f);
+    }
+
+    float SDLInput::GetGamepadAxis(int gamepad, GamepadAxis axis) const {
+        const Gamepad* pad = FindGamepad(gamepad);
+        return pad && axis < GamepadAxis::Count ? ReadAxis(pad->controller, axis) : 0.0f;
+    }
+
+    void SDLInput::Snapshot(InputSnapshot& out) const {
+        out.timestamp = SteadyNanoseconds();
+        out.keys      = m_Keys;
+        out.pointer   = m_Pointer;
+        for (int i = 0; i < kMaxGamepads; ++i) {
+            const Gamepad&   pad  = m_Gamepads[i];
+            GamepadSnapshot& snap = out.gamepads[i];
+            snap                  = GamepadSnapshot();
+            if (!pad.controller)
+                continue;
+            snap.connected = true;
+            snap.down      = pad.down;
+            snap.pressed   = pad.pressed;
+            snap.released  = pad.released;
+            for (size_t a = 0; a < snap.axes.size(); ++a)
+                snap.axes[a] = ReadAxis(pad.controller, static_cast<GamepadAxis>(a));
+        }
+    }
+
+    bool SDLInput::IsGamepadButtonDown(int gamepad, GamepadButton button) const {
+        const Gamepad* pad = FindGamepad(gamepad);
+        return pad && button < GamepadButton::Count && pad->down.test(static_cast<size_t>(button));
+    }
+
+    bool SDLInput::IsGamepadButtonPressed(int gamepad, GamepadButton button) const {
+        const Gamepad* pad = FindGamepad(gamepad);
+        return pad && button < GamepadButton::Count && pad->pressed.test(static_cast<size_t>(button));
+    }
+
+    bool SDLInput::IsGamepadButtonReleased(int gamepad, GamepadButton button) const {
+        const Gamepad* pad = FindGamepad(gamepad);
+        return pad && button < GamepadButton::Count && pad->released.test(static_cast<size_t>(button));
+    }
+
+    constexpr SDL_Scancode SDLInput::MapKey(Key key) {
         switch (key) {
             case Key::key_null:
                 return SDL_SCANCODE_UNKNOWN;
@@ -296,4 +607,18 @@ namespace ugfx::sdl {
         }
     }
 
+    Key SDLInput::ToKey(SDL_Scancode scancode) {
+        // Inverse of MapKey, built at compile time
+        static constexpr std::array<Key, SDL_NUM_SCANCODES> table = [] {
+            std::array<Key, SDL_NUM_SCANCODES> t{};
+            for (size_t k = kKeyCount - 1; k > 0; --k) {
+                const SDL_Scancode sc = MapKey(static_cast<Key>(k));
+                if (sc != SDL_SCANCODE_UNKNOWN)
+                    t[sc] = static_cast<Key>(k);
+            }
+            return t;
+        }();
+        return scancode >= 0 && scancode < SDL_NUM_SCANCODES ? table[scancode] : Key::key_null;
+    }
+
 }  // namespace ugfx::sdl
\ No newline at end of file
@@ -2,9 +2,8 @@
 
 #include <SDL2/SDL.h>
 
+#include <array>
 #include <bitset>
-#include <functional>
-#include <vector>
 
 #include "UniGraphics.h"
 
@@ -12,30 +11,70 @@ namespace ugfx::sdl {
 
     class SDLInput : public IInput {
        public:
-        SDLInput();
+        explicit SDLInput(FrameStats* stats = nullptr);
         ~SDLInput() override;
 
         void* GetHandle() const override;
 
         void ProcessEvents(void* event) override;
         void BeginFrame() override;
-        void RegisterEventCallback(EventCallback callback) override;
+        void EndFrame() override;
+
+        std::span<const InputEvent> GetEvents() const override { return m_Events.Events(); }
+        EventBus&                   GetEventBus() override { return m_Bus; }
+        void                        Snapshot(InputSnapshot& out) const override;
 
         bool IsKeyDown(ugfx::Key key) const override;
         bool IsKeyPressed(ugfx::Key key) const override;
         bool IsKeyReleased(ugfx::Key key) const override;
         bool IsKeyUp(ugfx::Key key) const override;
 
+        Vector2 GetMousePosition() const override { return m_Pointer.position; }
+        Vector2 GetMouseDelta() const override { return m_Pointer.delta; }
+        Vector2 GetMouseWheel() const override { return m_Pointer.wheel; }
+        bool    IsMouseButtonDown(MouseButton button) const override;
+        bool    IsMouseButtonPressed(MouseButton button) const override;
+        bool    IsMouseButtonReleased(MouseButton button) const override;
+        Vector2 ResamplePointer() override;
+        void    SetRawMotion(bool enabled) override;
+
+        bool  IsGamepadAvailable(int gamepad) const override;
+        float GetGamepadAxis(int gamepad, GamepadAxis axis) const override;
+        bool  IsGamepadButtonDown(int gamepad, GamepadButton button) const override;
+        bool  IsGamepadButtonPressed(int gamepad, GamepadButton button) const override;
+        bool  IsGamepadButtonReleased(int gamepad, GamepadButton button) const override;
+
        private:
-        std::bitset<SDL_NUM_SCANCODES> m_CurrentDown;
-        std::bitset<SDL_NUM_SCANCODES> m_PressedThisFrame;
-        std::bitset<SDL_NUM_SCANCODES> m_ReleasedThisFrame;
+        static constexpr int kMaxGamepads = InputSnapshot::kGamepads;
+
+        using GamepadButtons = std::bitset<static_cast<size_t>(GamepadButton::Count)>;
+        struct Gamepad {
+            SDL_GameController* controller = nullptr;
+            SDL_JoystickID      id         = -1;
+            GamepadButtons      down, pressed, released;
+        };
+
+        KeyboardState m_Keys;  // by ugfx::Key, so queries need no scancode mapping
+
+        InputEventQueue m_Events;
+        EventBus        m_Bus;
+        PointerState    m_Pointer;
+        FrameStats*     m_Stats = nullptr;
+
+        // The game controller subsystem comes up on the first gamepad query, which may be a const one
+        mutable std::array<Gamepad, kMaxGamepads> m_Gamepads;
+        mutable bool                              m_GamepadsInit = false;
 
-        std::vector<EventCallback> m_EventCallbacks;
+        void Translate(const SDL_Event& event);
 
-        SDL_Event m_LastEvent;
+        const Gamepad* FindGamepad(int slot) const;
+        Gamepad*       FindGamepadById(SDL_JoystickID id) const;
+        void           InitGamepads() const;
+        void           OpenGamepad(int deviceIndex) const;
+        void           HandleGamepadEvent(const SDL_Event& event);
 
-        SDL_Scancode MapKey(Key key) const;
+        static constexpr SDL_Scancode MapKey(Key key);
+        static Key                    ToKey(SDL_Scancode scancode);
     };
 
 }  // namespace ugfx::sdl
\ No newline at end of file
@@ -1,76 +1,275 @@
 #include "SDLRenderer.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <functional>
 #include <iostream>
 
-#include "Lexend.h"
+#include "SDLGlyphSource.h"
+#include "core/DrawBounds.h"
+#include "core/EmbeddedFont.h"
+#include "core/HarfBuzzGlyphSource.h"
+#include "core/SpriteBatch.h"
 
 #define M_PI 3.14159265358979323846  // pi
 
 namespace ugfx::sdl {
 
-    SDLRenderer::SDLRenderer(SDL_Window* window) {
-        if (!window) {
-            std::cerr << "SDL_Window is null in SDLRenderer constructor" << std::endl;
+    static constexpr int kDefaultFontSize  = 16;  // embedded Lexend when drawn without a size
+    static constexpr int kSdfBaseSize      = 48;  // distance field glyphs are rasterized once at this size
+    static constexpr int kBucketsPerOctave = 4;
+    static constexpr int kMinBucket        = -4 * kBucketsPerOctave;  // 1/16x to 8x the base size
+    static constexpr int kMaxBucket        = 3 * kBucketsPerOctave;
+
+    static constexpr size_t kTextCacheBudget = 16u << 20;  // bytes of cached text textures
+    static constexpr Color  kWhite           = {255, 255, 255, 255};
+
+    static SDL_BlendMode ToSDL(BlendMode mode) {
+        switch (mode) {
+            case BlendMode::Additive:
+                return SDL_BLENDMODE_ADD;
+            case BlendMode::Multiply:
+                return SDL_BLENDMODE_MOD;
+            case BlendMode::None:
+                return SDL_BLENDMODE_NONE;
+            case BlendMode::Alpha:
+            default:
+                return SDL_BLENDMODE_BLEND;
+        }
+    }
+
+    // SDL_image and SDL_ttf come up on first use rather than with the backend, which quits them. The cost is
+    // recorded in FrameStats::startup.
+    static void InitImage(FrameStats& stats) {
+        if (IMG_Init(0) != 0)
             return;
+        const auto start = std::chrono::steady_clock::now();
+        if (IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) == 0)
+            std::cerr << "IMG_Init failed: " << IMG_GetError() << std::endl;  // built-in formats still load
+        stats.startup.imageInit += MillisecondsSince(start);
+    }
+
+    static bool InitFonts(FrameStats& stats) {
+        if (TTF_WasInit())
+            return true;
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok    = TTF_Init() == 0;
+        stats.startup.fontInit += MillisecondsSince(start);
+        if (!ok)
+            std::cerr << "TTF_Init failed: " << TTF_GetError() << std::endl;
+        return ok;
+    }
+
+    // Shapes with HarfBuzz when built with it, otherwise rasterizes code point by code point through SDL_ttf
+    static std::unique_ptr<IGlyphSource> OpenSdfSource(const std::string& path, FrameStats& stats) {
+        if (HarfBuzzAvailable()) {
+            size_t size = 0;
+            void*  data = SDL_LoadFile(path.c_str(), &size);
+            if (!data) {
+                std::cerr << "Failed to read font file: " << SDL_GetError() << std::endl;
+                return nullptr;
+            }
+            std::vector<uint8_t> bytes(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+            SDL_free(data);
+            return CreateHarfBuzzGlyphSource(std::move(bytes), kSdfBaseSize);
         }
-        m_Renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+
+        TTF_Font* font = InitFonts(stats) ? TTF_OpenFont(path.c_str(), kSdfBaseSize) : nullptr;
+        if (!font) {
+            std::cerr << "Failed to load SDF font: " << TTF_GetError() << std::endl;
+            return nullptr;
+        }
+        return std::make_unique<SDLGlyphSource>(font, kSdfBaseSize);
+    }
+
+    SDLRenderer::SDLRenderer(FrameStats* stats)
+        : Renderer(stats), m_TextCache(kTextCacheBudget, [this](TextEntry& e) { ReleaseText(e); }) {
+    }
+
+    bool SDLRenderer::Attach(SDL_Window* window) {
+        if (!window) {
+            std::cerr << "SDL_Window is null in SDLRenderer::Attach" << std::endl;
+            return false;
+        }
+        if (m_Renderer)
+            return true;
+
+        const auto   start = std::chrono::steady_clock::now();
+        const Uint32 vsync = m_VSync != VSyncMode::Off ? SDL_RENDERER_PRESENTVSYNC : 0;
+        m_Renderer         = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | vsync);
         if (!m_Renderer) {
             std::cerr << "SDL_CreateRenderer (accelerated) failed: " << SDL_GetError() << std::endl;
-            m_Renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+            m_Renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE | vsync);
             if (!m_Renderer) {
                 std::cerr << "SDL_CreateRenderer (software) failed: " << SDL_GetError() << std::endl;
-                return;
+                return false;
             }
             std::cout << "Using software renderer as fallback" << std::endl;
         }
-        SDL_SetRenderDrawBlendMode(m_Renderer, SDL_BLENDMODE_BLEND);
+        m_StateCache.Attach(m_Renderer, m_Stats);
+        m_PresentVSync = vsync != 0;
 
-        // Create RWops from memory
-        SDL_RWops* rw = SDL_RWFromConstMem(Lexend_ttf, Lexend_ttf_len);
-        if (!rw) {
-            std::cerr << "SDL_RWFromConstMem failed\n";
-            return;
-        }
+        // Changing the swap interval resets the device on direct3d (D3D9), dropping render target contents
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(m_Renderer, &info) == 0 && info.name)
+            m_CheapSwapInterval = std::strcmp(info.name, "opengl") == 0 || std::strcmp(info.name, "direct3d11") == 0;
 
-        // Open font from RWops, 16px default size
-        m_DefaultFont = TTF_OpenFontRW(rw, 1, 16);  // 1 = auto-free RWops
-        if (!m_DefaultFont) {
-            std::cerr << "Failed to load embedded default font: " << TTF_GetError() << "\n";
-        }
+        SDL_DisplayMode mode;
+        if (SDL_GetWindowDisplayMode(window, &mode) == 0 && mode.refresh_rate > 0)
+            m_RefreshMs = 1000.0f / static_cast<float>(mode.refresh_rate);
+
+        m_Stats->startup.rendererCreate = MillisecondsSince(start);
+        return true;
     }
 
     SDLRenderer::~SDLRenderer() {
+        // Textures go before the renderer that owns them
+        ReleaseAllResources();
+        m_DefaultSdf.reset();
+        if (m_SceneTarget)
+            SDL_DestroyTexture(m_SceneTarget);
         if (m_DefaultFont)
             TTF_CloseFont(m_DefaultFont);
         if (m_Renderer)
             SDL_DestroyRenderer(m_Renderer);
-
-        ReleaseAllResources();
     }
 
-    void SDLRenderer::BeginDrawing() {
+    void SDLRenderer::BeginFrame() {
         if (!m_Renderer) {
             std::cerr << "Renderer is null in BeginDrawing" << std::endl;
+            return;
+        }
+
+        // Resync once per frame in case the SDL_Renderer was used directly through GetHandle()
+        m_StateCache.Invalidate();
+
+        const float scale = RenderScale();
+        m_SceneActive     = scale < 1.0f && BeginScaledFrame(scale);
+        if (!m_SceneActive)
+            m_Stats->renderScale = 1.0f;
+
+        m_StateCache.SetClipRect(m_ClipEnabled ? &m_ClipRect : nullptr);
+    }
+
+    bool SDLRenderer::BeginScaledFrame(float scale) {
+        if (m_SceneFailed)
+            return false;
+
+        int width, height;  // no target is set yet, so this is the window
+        if (SDL_GetRendererOutputSize(m_Renderer, &width, &height) != 0)
+            return false;
+
+        if (!m_SceneTarget || width != m_SceneWidth || height != m_SceneHeight) {
+            if (m_SceneTarget)
+                SDL_DestroyTexture(m_SceneTarget);
+            m_SceneTarget = nullptr;
+            if (SDL_RenderTargetSupported(m_Renderer))
+                m_SceneTarget =
+                    SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+            if (!m_SceneTarget) {
+                std::cerr << "Dynamic resolution unavailable, no render target: " << SDL_GetError() << std::endl;
+                m_SceneFailed = true;
+                return false;
+            }
+            SDL_SetTextureBlendMode(m_SceneTarget, SDL_BLENDMODE_NONE);
+            SDL_SetTextureScaleMode(m_SceneTarget, SDL_ScaleModeLinear);
+            m_SceneWidth  = width;
+            m_SceneHeight = height;
+        }
+
+        // Clip rects and the viewport are given in draw coordinates and scaled by SDL along with everything else
+        m_StateCache.SetTarget(m_SceneTarget);
+        SDL_RenderSetScale(m_Renderer, scale, scale);
+        const SDL_Rect viewport = {0, 0, width, height};
+        SDL_RenderSetViewport(m_Renderer, &viewport);
+
+        m_SceneRect          = {0, 0, static_cast<int>(std::lround(width * scale)),
+                                static_cast<int>(std::lround(height * scale))};
+        m_Stats->renderScale = scale;
+        return true;
+    }
+
+    void SDLRenderer::EndFrame() {
+        if (!m_Renderer)
+            return;
+
+        if (m_SceneActive) {
+            // Back on the window SDL restores its viewport, clip and scale; the clip belongs to the scene only
+            m_StateCache.SetTarget(nullptr);
+            m_StateCache.SetClipRect(nullptr);
+            SDL_RenderCopy(m_Renderer, m_SceneTarget, &m_SceneRect, nullptr);
         }
+        if (m_VSync == VSyncMode::Adaptive && m_CheapSwapInterval)
+            UpdateAdaptiveVSync();
+        SDL_RenderPresent(m_Renderer);
+        m_LastPresent = std::chrono::steady_clock::now();
     }
 
-    void SDLRenderer::EndDrawing() {
+    // SDL2 renderers have no adaptive swap interval, so emulate it: once frames keep taking longer than a refresh
+    // they present right away (tearing) instead of waiting for the next vblank and halving the rate. Switching
+    // takes kAdaptiveStreak frames in a row either way, so a frame near the refresh interval does not toggle it.
+    void SDLRenderer::UpdateAdaptiveVSync() {
+        const auto elapsed = std::chrono::steady_clock::now() - m_LastPresent;
+        const bool late    = std::chrono::duration<float, std::milli>(elapsed).count() > m_RefreshMs;
+        if (late != m_PresentVSync) {
+            m_AdaptiveStreak = 0;
+            return;
+        }
+        if (++m_AdaptiveStreak >= kAdaptiveStreak) {
+            m_AdaptiveStreak = 0;
+            SetPresentVSync(!late);
+        }
+    }
+
+    void SDLRenderer::SetVSync(VSyncMode mode) {
+        m_VSync          = mode;
+        m_AdaptiveStreak = 0;
         if (m_Renderer)
-            SDL_RenderPresent(m_Renderer);
+            SetPresentVSync(mode != VSyncMode::Off);
     }
 
-    void SDLRenderer::Clear(Color color) {
+    void SDLRenderer::SetPresentVSync(bool enabled) {
+        if (enabled == m_PresentVSync)
+            return;
+        if (SDL_RenderSetVSync(m_Renderer, enabled ? 1 : 0) != 0) {
+            std::cerr << "SDL_RenderSetVSync failed: " << SDL_GetError() << std::endl;
+            m_VSync = VSyncMode::Off;  // do not retry every frame
+            return;
+        }
+        m_PresentVSync = enabled;
+    }
+
+    void SDLRenderer::RenderClear(Color color) {
         if (!m_Renderer)
             return;
-        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        m_StateCache.SetDrawColor(color);
         SDL_RenderClear(m_Renderer);
     }
 
+    Rectangle SDLRenderer::GetViewport() const {
+        if (!m_Renderer)
+            return {};
+        SDL_Rect viewport;
+        SDL_RenderGetViewport(m_Renderer, &viewport);  // draw coordinates are relative to the viewport origin
+        return {0.0f, 0.0f, static_cast<float>(viewport.w), static_cast<float>(viewport.h)};
+    }
+
     void SDLRenderer::ReleaseAllResources() {
+        ReleaseBitmapFonts();
+        m_TextCache.Clear();
+        m_Stats->textCacheBytes = 0;
+        m_TextObjects.Clear([this](TextEntry* e) {
+            ReleaseText(*e);
+            delete e;
+        });
         m_TextureManager.Clear([](SDL_Texture* t) { SDL_DestroyTexture(t); });
-        m_FontManager.Clear([](TTF_Font* f) { TTF_CloseFont(f); });
+        m_FontManager.Clear([this](FontEntry* f) { DestroyFont(f); });
+        if (m_DefaultSdf)
+            DestroyBuckets(*m_DefaultSdf);
+        m_StateCache.ForgetAllTextures();
         if (m_Renderer)
             SDL_RenderClear(m_Renderer);
         std::cout << "SDLRenderer: All textures/fonts released.\n";
@@ -80,18 +279,41 @@ namespace ugfx::sdl {
         return m_Renderer;
     }
 
-    void SDLRenderer::DrawPixel(Vector2 pos, Color color) {
+    void SDLRenderer::ApplyBlendMode(BlendMode mode) {
+        m_BlendMode = ToSDL(mode);
+    }
+
+    void SDLRenderer::ApplyClipRect(const Rectangle* rect) {
+        m_ClipEnabled = rect != nullptr;
+        if (rect)
+            m_ClipRect = {static_cast<int>(rect->x), static_cast<int>(rect->y), static_cast<int>(rect->width),
+                          static_cast<int>(rect->height)};
+        if (m_Renderer)
+            m_StateCache.SetClipRect(m_ClipEnabled ? &m_ClipRect : nullptr);
+    }
+
+    void SDLRenderer::ApplyDrawState(Color color) {
+        m_StateCache.SetDrawBlendMode(m_BlendMode);
+        m_StateCache.SetDrawColor(color);
+    }
+
+    void SDLRenderer::ApplyTextureState(SDL_Texture* texture, Color tint) {
+        m_StateCache.SetTextureBlendMode(texture, m_BlendMode);
+        m_StateCache.SetTextureMod(texture, tint);
+    }
+
+    void SDLRenderer::RenderPixel(Vector2 pos, Color color) {
         if (!m_Renderer)
             return;
-        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        ApplyDrawState(color);
         SDL_RenderDrawPointF(m_Renderer, pos.x, pos.y);
     }
 
-    void SDLRenderer::DrawLine(Vector2 start, Vector2 end, float thickness, Color color) {
+    void SDLRenderer::RenderLine(Vector2 start, Vector2 end, float thickness, Color color) {
         if (!m_Renderer)
             return;
 
-        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        ApplyDrawState(color);
 
         if (thickness <= 1.0f) {
             SDL_RenderDrawLineF(m_Renderer, start.x, start.y, end.x, end.y);
@@ -116,25 +338,25 @@ namespace ugfx::sdl {
         Vector2 v4 = {end.x - px, end.y - py};
 
         // Fill triangles (your DrawTriangle from before!)
-        DrawTriangle(v1, v2, v3, color);
-        DrawTriangle(v2, v3, v4, color);
+        RenderTriangle(v1, v2, v3, color);
+        RenderTriangle(v2, v3, v4, color);
     }
 
-    void SDLRenderer::DrawRectangle(Rectangle rec, Color color) {
+    void SDLRenderer::RenderRectangle(Rectangle rec, Color color) {
         if (!m_Renderer) {
             std::cerr << "Renderer is null in DrawRectangle" << std::endl;
             return;
         }
-        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        ApplyDrawState(color);
         SDL_FRect rect = {rec.x, rec.y, rec.width, rec.height};
         SDL_RenderFillRectF(m_Renderer, &rect);
     }
 
-    void SDLRenderer::DrawRectangleLines(Rectangle rec, float thickness, Color color) {
+    void SDLRenderer::RenderRectangleLines(Rectangle rec, float thickness, Color color) {
         if (!m_Renderer)
             return;
 
-        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        ApplyDrawState(color);
 
         SDL_FRect top    = {rec.x, rec.y, rec.width, thickness};
         SDL_FRect bottom = {rec.x, rec.y + rec.height - thickness, rec.width, thickness};
@@ -147,11 +369,11 @@ namespace ugfx::sdl {
         SDL_RenderFillRectF(m_Renderer, &right);
     }
 
-    void SDLRenderer::DrawCircle(Vector2 center, float radius, Color color) {
+    void SDLRenderer::RenderCircle(Vector2 center, float radius, Color color) {
         if (!m_Renderer)
             return;
 
-        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        ApplyDrawState(color);
 
         int yStart = static_cast<int>(center.y - radius);
         int yEnd   = static_cast<int>(center.y + radius);
@@ -165,7 +387,7 @@ namespace ugfx::sdl {
         }
     }
 
-    void SDLRenderer::DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
+    void SDLRenderer::RenderTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
         if (!m_Renderer)
             return;
 
@@ -191,7 +413,7 @@ namespace ugfx::sdl {
             SDL_RenderDrawLine(m_Renderer, x1, y, x2, y);
         };
 
-        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        ApplyDrawState(color);
 
         auto edgeInterp = [](Point a, Point b, int y) -> int {
             if (a.y == b.y)
@@ -218,6 +440,7 @@ namespace ugfx::sdl {
         if (!m_Renderer)
             return {0, 0, 0};
 
+        InitImage(*m_Stats);
         SDL_Texture* tex = IMG_LoadTexture(m_Renderer, path.c_str());
         if (!tex) {
             std::cerr << "Failed to load texture: " << IMG_GetError() << std::endl;
@@ -226,6 +449,7 @@ namespace ugfx::sdl {
 
         int w, h;
         SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
+        m_StateCache.ForgetTexture(tex);  // the address may belong to a texture destroyed earlier
         unsigned int id = m_TextureManager.Add(tex);
         return {static_cast<int>(id), w, h};
     }
@@ -233,32 +457,35 @@ namespace ugfx::sdl {
     void SDLRenderer::UnloadTexture(Texture tex) {
         SDL_Texture* t = m_TextureManager.Get(tex.id);
         if (t) {
+            m_StateCache.ForgetTexture(t);
             SDL_DestroyTexture(t);
             m_TextureManager.Remove(tex.id);
         }
     }
 
-    void SDLRenderer::DrawTexture(Texture tex, Vector2 pos, Color tint) {
+    void SDLRenderer::RenderTexture(Texture tex, Vector2 pos, Color tint) {
         if (!m_Renderer || tex.id == 0)
             return;
 
         SDL_Texture* realTex = m_TextureManager.Get(tex.id);
+        if (!realTex)
+            return;
 
-        SDL_SetTextureColorMod(realTex, tint.r, tint.g, tint.b);
-        SDL_SetTextureAlphaMod(realTex, tint.a);
+        ApplyTextureState(realTex, tint);
 
         SDL_FRect dst = {pos.x, pos.y, static_cast<float>(tex.width), static_cast<float>(tex.height)};
         SDL_RenderCopyF(m_Renderer, realTex, nullptr, &dst);
     }
 
-    void SDLRenderer::DrawTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) {
+    void SDLRenderer::RenderTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) {
         if (!m_Renderer || tex.id == 0)
             return;
 
         SDL_Texture* realTex = m_TextureManager.Get(tex.id);
+        if (!realTex)
+            return;
 
-        SDL_SetTextureColorMod(realTex, tint.r, tint.g, tint.b);
-        SDL_SetTextureAlphaMod(realTex, tint.a);
+        ApplyTextureState(realTex, tint);
 
         SDL_Rect  srcRect = {static_cast<int>(src.x), static_cast<int>(src.y), static_cast<int>(src.width),
                              static_cast<int>(src.height)};
@@ -266,16 +493,15 @@ namespace ugfx::sdl {
         SDL_RenderCopyF(m_Renderer, realTex, &srcRect, &dstRect);
     }
 
-    void SDLRenderer::DrawTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
-                                        Flip flip, Color tint) {
+    void SDLRenderer::RenderTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin,
+                                          float rotation, Flip flip, Color tint) {
         if (!m_Renderer || texture.id == -1)
             return;
         SDL_Texture* realTex = m_TextureManager.Get(texture.id);
         if (!realTex)
             return;
 
-        SDL_SetTextureColorMod(realTex, tint.r, tint.g, tint.b);
-        SDL_SetTextureAlphaMod(realTex, tint.a);
+        ApplyTextureState(realTex, tint);
 
         SDL_FRect  dst     = {dest.x, dest.y, dest.width, dest.height};
         SDL_FPoint center  = {origin.x, origin.y};
@@ -299,13 +525,14 @@ namespace ugfx::sdl {
         SDL_RenderCopyExF(m_Renderer, realTex, &srcRect, &dst, rotation, &center, sdlFlip);
     }
 
-    void SDLRenderer::DrawTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
-                                    Color tint) {
+    void SDLRenderer::RenderTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale,
+                                      Flip flip, Color tint) {
         if (!m_Renderer || tex.id == 0)
             return;
         SDL_Texture* realTex = m_TextureManager.Get(tex.id);
-        SDL_SetTextureColorMod(realTex, tint.r, tint.g, tint.b);
-        SDL_SetTextureAlphaMod(realTex, tint.a);
+        if (!realTex)
+            return;
+        ApplyTextureState(realTex, tint);
 
         SDL_FRect dst = {pos.x - (origin.x * scale), pos.y - (origin.y * scale), tex.width * scale, tex.height * scale};
         SDL_FPoint center = {origin.x * scale, origin.y * scale};
@@ -318,56 +545,349 @@ namespace ugfx::sdl {
         SDL_RenderCopyExF(m_Renderer, realTex, nullptr, &dst, rotation, &center, sdlFlip);
     }
 
+    static_assert(sizeof(SDL_Vertex) == sizeof(Vertex2D) && offsetof(SDL_Vertex, color) == offsetof(Vertex2D, color) &&
+                      offsetof(SDL_Vertex, tex_coord) == offsetof(Vertex2D, texCoord),
+                  "Vertex2D must stay layout-compatible with SDL_Vertex");
+
+    void SDLRenderer::RenderGeometry(Texture tex, std::span<const Vertex2D> vertices, std::span<const int> indices) {
+        if (!m_Renderer || vertices.empty())
+            return;
+
+        SDL_Texture* realTex = m_TextureManager.Get(tex.id);
+        if (realTex)
+            ApplyTextureState(realTex, {255, 255, 255, 255});  // vertex colors carry the tint
+        else
+            m_StateCache.SetDrawBlendMode(m_BlendMode);
+
+        SDL_RenderGeometry(m_Renderer, realTex, reinterpret_cast<const SDL_Vertex*>(vertices.data()),
+                           static_cast<int>(vertices.size()), indices.empty() ? nullptr : indices.data(),
+                           static_cast<int>(indices.size()));
+    }
+
     Font SDLRenderer::LoadFont(const std::string& path, int size) {
-        TTF_Font* font = TTF_OpenFont(path.c_str(), size);
+        TTF_Font* font = InitFonts(*m_Stats) ? TTF_OpenFont(path.c_str(), size) : nullptr;
         if (!font) {
             std::cerr << "Failed to load font: " << TTF_GetError() << std::endl;
             return {0};
         }
-        int id = m_FontManager.Add(font);
+        int id = m_FontManager.Add(new FontEntry{font, size, nullptr, std::make_unique<SDLFontMetrics>(font, size)});
+        return {id};
+    }
+
+    Font SDLRenderer::LoadSdfFont(const std::string& path) {
+        std::unique_ptr<IGlyphSource> source = OpenSdfSource(path, *m_Stats);
+        if (!source)
+            return {0};
+        auto sdf = std::make_unique<SdfFont>(std::move(source));
+        int  id  = m_FontManager.Add(new FontEntry{nullptr, kSdfBaseSize, std::move(sdf), nullptr});
         return {id};
     }
 
+    bool SDLRenderer::AddFallbackFont(Font font, const std::string& path) {
+        FontEntry* f   = m_FontManager.Get(font.id);
+        SdfFont*   sdf = f ? f->sdf.get() : DefaultSdfFont();
+        if (!sdf) {
+            std::cerr << "AddFallbackFont: only distance field fonts take fallbacks" << std::endl;
+            return false;
+        }
+        std::unique_ptr<IGlyphSource> source = OpenSdfSource(path, *m_Stats);
+        if (!source)
+            return false;
+        sdf->atlas.AddFallback(std::move(source));
+        return true;
+    }
+
     void SDLRenderer::UnloadFont(Font font) {
-        TTF_Font* f = m_FontManager.Get(font.id);
+        if (UnloadBitmapFont(font))
+            return;
+        FontEntry* f = m_FontManager.Get(font.id);
         if (f) {
-            TTF_CloseFont(f);
+            m_TextCache.EraseFont(font.id);
+            m_Stats->textCacheBytes = m_TextCache.Bytes();
+            DestroyFont(f);
             m_FontManager.Remove(font.id);
         }
     }
 
-    void SDLRenderer::DrawText(Font font, const std::string& text, Vector2 pos, Color color) {
-        if (!m_Renderer)
+    void SDLRenderer::DestroyFont(FontEntry* font) {
+        if (font->raster)
+            TTF_CloseFont(font->raster);
+        if (font->sdf)
+            DestroyBuckets(*font->sdf);
+        delete font;
+    }
+
+    void SDLRenderer::DestroyBuckets(SdfFont& font) {
+        for (auto& [index, bucket] : font.buckets) {
+            m_StateCache.ForgetTexture(bucket.texture);
+            SDL_DestroyTexture(bucket.texture);
+        }
+        font.buckets.clear();
+    }
+
+    // The embedded font is only decompressed and parsed once text actually uses it
+    static TTF_Font* OpenDefaultFont(int size, FrameStats& stats) {
+        if (!InitFonts(stats))
+            return nullptr;
+        const std::span<const uint8_t> data = DefaultFontData();
+        SDL_RWops* rw = data.empty() ? nullptr : SDL_RWFromConstMem(data.data(), static_cast<int>(data.size()));
+        return rw ? TTF_OpenFontRW(rw, 1, size) : nullptr;  // 1 = auto-free RWops
+    }
+
+    TTF_Font* SDLRenderer::DefaultRasterFont() {
+        if (m_DefaultFont)
+            return m_DefaultFont;
+
+        m_DefaultFont = OpenDefaultFont(kDefaultFontSize, *m_Stats);
+        if (!m_DefaultFont) {
+            std::cerr << "Failed to load embedded default font: " << TTF_GetError() << "\n";
+            return nullptr;
+        }
+        m_DefaultMetrics = std::make_unique<SDLFontMetrics>(m_DefaultFont, kDefaultFontSize);
+        return m_DefaultFont;
+    }
+
+    SDLRenderer::SdfFont* SDLRenderer::DefaultSdfFont() {
+        if (m_DefaultSdf)
+            return m_DefaultSdf.get();
+
+        std::unique_ptr<IGlyphSource> source;
+        if (HarfBuzzAvailable()) {
+            const std::span<const uint8_t> data = DefaultFontData();
+            source = CreateHarfBuzzGlyphSource({data.begin(), data.end()}, kSdfBaseSize);
+        } else if (TTF_Font* font = OpenDefaultFont(kSdfBaseSize, *m_Stats)) {
+            source = std::make_unique<SDLGlyphSource>(font, kSdfBaseSize);
+        }
+        if (!source) {
+            std::cerr << "Failed to load embedded SDF font: " << TTF_GetError() << "\n";
+            return nullptr;
+        }
+        m_DefaultSdf = std::make_unique<SdfFont>(std::move(source));
+        return m_DefaultSdf.get();
+    }
+
+    SDL_Texture* SDLRenderer::BucketTexture(SdfFont& font, float scale) {
+        const int index = std::clamp(static_cast<int>(std::lround(std::log2(scale) * kBucketsPerOctave)), kMinBucket,
+                                     kMaxBucket);
+
+        const GlyphAtlas& atlas  = font.atlas;
+        SdfFont::Bucket&  bucket = font.buckets[index];
+        if (bucket.texture && bucket.version == atlas.Version())
+            return bucket.texture;
+
+        if (bucket.texture && bucket.height != atlas.Height()) {
+            m_StateCache.ForgetTexture(bucket.texture);
+            SDL_DestroyTexture(bucket.texture);
+            bucket.texture = nullptr;
+        }
+        if (!bucket.texture) {
+            bucket.texture = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                               atlas.Width(), atlas.Height());
+            if (!bucket.texture) {
+                std::cerr << "Failed to create SDF bucket texture: " << SDL_GetError() << std::endl;
+                font.buckets.erase(index);
+                return nullptr;
+            }
+            SDL_SetTextureScaleMode(bucket.texture, SDL_ScaleModeLinear);
+            m_StateCache.ForgetTexture(bucket.texture);
+            bucket.height = atlas.Height();
+        }
+
+        // Alpha is the coverage a pixel of this size gets at each stored distance: d * scale screen pixels
+        // from the outline, centred on the edge
+        const float bucketScale = std::exp2(static_cast<float>(index) / kBucketsPerOctave);
+        const float spread      = static_cast<float>(atlas.Spread());
+        uint32_t    lut[256];
+        for (int v = 0; v < 256; ++v) {
+            float d = (v - 128) / 127.0f * spread;
+            float a = std::clamp(d * bucketScale + 0.5f, 0.0f, 1.0f);
+            lut[v]  = (static_cast<uint32_t>(a * 255.0f + 0.5f) << 24) | 0x00FFFFFFu;
+        }
+
+        const std::vector<uint8_t>& field = atlas.Pixels();
+        m_BucketPixels.resize(field.size());
+        for (size_t i = 0; i < field.size(); ++i)
+            m_BucketPixels[i] = lut[field[i]];
+        SDL_UpdateTexture(bucket.texture, nullptr, m_BucketPixels.data(), atlas.Width() * 4);
+
+        bucket.version = atlas.Version();
+        return bucket.texture;
+    }
+
+    IGlyphMetrics* SDLRenderer::GetGlyphMetrics(Font font, float fontSize) {
+        // Mirrors the font selection in RenderText
+        if (FontEntry* f = m_FontManager.Get(font.id))
+            return f->sdf ? static_cast<IGlyphMetrics*>(&f->sdf->atlas) : f->metrics.get();
+        if (fontSize > 0.0f) {
+            SdfFont* sdf = DefaultSdfFont();
+            return sdf ? &sdf->atlas : nullptr;
+        }
+        return DefaultRasterFont() ? m_DefaultMetrics.get() : nullptr;
+    }
+
+    // Distance field text already reuses atlas glyphs and shaped runs, so only raster text goes through the cache.
+    // Entries are tinted when drawn, so one serves every color.
+    void SDLRenderer::RenderText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) {
+        if (!m_Renderer || text.empty())
             return;
 
-        TTF_Font* f = m_FontManager.Get(font.id);
-        if (!f)
-            f = m_DefaultFont;
+        FontEntry* f = m_FontManager.Get(font.id);
+        if (f && f->sdf) {
+            RenderSdfText(*f->sdf, text, pos, fontSize > 0.0f ? fontSize : static_cast<float>(f->size), color);
+            return;
+        }
+        if (!f && fontSize > 0.0f) {
+            if (SdfFont* sdf = DefaultSdfFont())
+                RenderSdfText(*sdf, text, pos, fontSize, color);
+            return;
+        }
 
-        SDL_Color    c    = {color.r, color.g, color.b, color.a};
-        SDL_Surface* surf = TTF_RenderText_Solid(f, text.c_str(), c);
+        const int   key  = f ? font.id : 0;  // 0 is never a valid id: the embedded raster font
+        const int   size  = f && fontSize > 0.0f ? static_cast<int>(fontSize) : f ? f->size : 0;
+        TextEntry*  entry = m_TextCache.Find(key, static_cast<float>(size), kWhite, text);
+        if (entry) {
+            ++m_Stats->textCacheHits;
+        } else {
+            ++m_Stats->textCacheMisses;
+            TextEntry baked;
+            if (!BakeText(font, text, fontSize, kWhite, baked))
+                return;
+            const size_t bytes = static_cast<size_t>(baked.bounds.width * baked.bounds.height) * 4;
+            entry = &m_TextCache.Insert(key, static_cast<float>(size), kWhite, text, std::move(baked), bytes);
+            m_Stats->textCacheBytes = m_TextCache.Bytes();
+        }
+        DrawTextEntry(*entry, pos, color);
+    }
+
+    void SDLRenderer::RenderSdfText(SdfFont& font, const std::string& text, Vector2 pos, float fontSize, Color color) {
+        m_TextVertices.clear();
+        font.atlas.BuildQuads(text, pos, fontSize, color, m_TextVertices);
+        DrawSdfVertices(font, fontSize);
+    }
+
+    // Draws the quads in m_TextVertices; call after building them, which may have added glyphs to the atlas
+    void SDLRenderer::DrawSdfVertices(SdfFont& font, float fontSize) {
+        const size_t quads = m_TextVertices.size() / 4;
+        if (quads == 0)
+            return;
+
+        SDL_Texture* tex = BucketTexture(font, font.atlas.Scale(fontSize));
+        if (!tex)
+            return;
+
+        BuildQuadIndices(quads, m_TextIndices);
+        ApplyTextureState(tex, kWhite);  // vertex colors carry the text color
+        SDL_RenderGeometry(m_Renderer, tex, reinterpret_cast<const SDL_Vertex*>(m_TextVertices.data()),
+                           static_cast<int>(m_TextVertices.size()), m_TextIndices.data(), static_cast<int>(quads * 6));
+    }
+
+    // Mirrors the font selection in RenderText. color only goes into distance field vertices; raster text is
+    // rendered white.
+    bool SDLRenderer::BakeText(Font font, const std::string& text, float fontSize, Color color, TextEntry& out) {
+        FontEntry* f   = m_FontManager.Get(font.id);
+        SdfFont*   sdf = f ? f->sdf.get() : fontSize > 0.0f ? DefaultSdfFont() : nullptr;
+        if (sdf) {
+            out.font     = f ? font.id : -1;
+            out.fontSize = fontSize > 0.0f ? fontSize : static_cast<float>(f->size);
+            sdf->atlas.BuildQuads(text, {0.0f, 0.0f}, out.fontSize, color, out.vertices);
+            out.atlasHeight = sdf->atlas.Height();
+            out.bounds      = BoundsOfVertices(out.vertices);
+            return true;
+        }
+
+        TTF_Font* raster = f ? f->raster : DefaultRasterFont();
+        if (!raster || text.empty())
+            return false;
+
+        const bool resize = f && fontSize > 0.0f && static_cast<int>(fontSize) != f->size;
+        if (resize)
+            TTF_SetFontSize(raster, static_cast<int>(fontSize));
+        SDL_Surface* surf = TTF_RenderUTF8_Blended(raster, text.c_str(), {255, 255, 255, 255});
+        if (resize)
+            TTF_SetFontSize(raster, f->size);
         if (!surf) {
             std::cerr << "Failed to render text: " << TTF_GetError() << std::endl;
-            return;
+            return false;
         }
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(m_Renderer, surf);
-        if (!tex) {
+
+        out.texture = SDL_CreateTextureFromSurface(m_Renderer, surf);
+        out.bounds  = {0.0f, 0.0f, static_cast<float>(surf->w), static_cast<float>(surf->h)};
+        SDL_FreeSurface(surf);
+        if (!out.texture) {
             std::cerr << "Failed to create texture from surface: " << SDL_GetError() << std::endl;
-            SDL_FreeSurface(surf);
-            return;
+            return false;
         }
-        SDL_FRect dst = {pos.x, pos.y, (float) surf->w, (float) surf->h};
-        SDL_RenderCopyF(m_Renderer, tex, nullptr, &dst);
-        SDL_DestroyTexture(tex);
-        SDL_FreeSurface(surf);
+        m_StateCache.ForgetTexture(out.texture);  // the address may belong to a texture destroyed earlier
+        return true;
     }
 
-    void SDLRenderer::DrawText(const std::string& text, Vector2 pos, int fontSize, Color color) {
-        if (!m_Renderer || !m_DefaultFont)
+    void SDLRenderer::DrawTextEntry(TextEntry& entry, Vector2 pos, Color tint) {
+        if (entry.texture) {
+            ApplyTextureState(entry.texture, tint);
+            SDL_FRect dst = {pos.x + entry.bounds.x, pos.y + entry.bounds.y, entry.bounds.width, entry.bounds.height};
+            SDL_RenderCopyF(m_Renderer, entry.texture, nullptr, &dst);
             return;
+        }
+
+        // -1 was baked with the default font; an unloaded font leaves quads pointing into a freed atlas
+        FontEntry* f   = m_FontManager.Get(entry.font);
+        SdfFont*   sdf = entry.font == -1 ? DefaultSdfFont() : f ? f->sdf.get() : nullptr;
+        if (!sdf || entry.vertices.empty())
+            return;
+
+        if (const int height = sdf->atlas.Height(); height != entry.atlasHeight) {
+            const float rescale = static_cast<float>(entry.atlasHeight) / static_cast<float>(height);
+            for (Vertex2D& v : entry.vertices)
+                v.texCoord.y *= rescale;
+            entry.atlasHeight = height;
+        }
+
+        m_TextVertices.assign(entry.vertices.begin(), entry.vertices.end());
+        for (Vertex2D& v : m_TextVertices) {
+            v.position.x += pos.x;
+            v.position.y += pos.y;
+        }
+        DrawSdfVertices(*sdf, entry.fontSize);
+    }
+
+    void SDLRenderer::ReleaseText(TextEntry& entry) {
+        if (entry.texture) {
+            m_StateCache.ForgetTexture(entry.texture);
+            SDL_DestroyTexture(entry.texture);
+            entry.texture = nullptr;
+        }
+    }
+
+    // ------------------- Text objects -------------------
+
+    TextObject SDLRenderer::CreateTextObject(Font font, const std::string& text, float fontSize, Color color) {
+        if (!m_Renderer)
+            return {};
+
+        auto entry = std::make_unique<TextEntry>();
+        if (!BakeText(font, text, fontSize, color, *entry))
+            return {};
+        entry->tint = color;
+        const Rectangle bounds = entry->bounds;
+        return {m_TextObjects.Add(entry.release()), bounds};
+    }
+
+    void SDLRenderer::RenderTextObject(TextObject object, Vector2 pos) {
+        if (TextEntry* entry = m_TextObjects.Get(object.id); entry && m_Renderer)
+            DrawTextEntry(*entry, pos, entry->tint);
+    }
+
+    void SDLRenderer::DestroyTextObject(TextObject object) {
+        if (TextEntry* entry = m_TextObjects.Get(object.id)) {
+            ReleaseText(*entry);
+            delete entry;
+            m_TextObjects.Remove(object.id);
+        }
+    }
 
-        TTF_SetFontSize(m_DefaultFont, fontSize);
-        DrawText(Font{0}, text, pos, color);  // 0 = use m_DefaultFont
+    void SDLRenderer::SetTextCacheBudget(size_t bytes) {
+        m_TextCache.SetBudget(bytes);
+        m_Stats->textCacheBytes = m_TextCache.Bytes();
     }
 
 }  // namespace ugfx::sdl
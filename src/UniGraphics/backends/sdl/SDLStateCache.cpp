@@ -0,0 +1,96 @@
+#include "SDLStateCache.h"
+
+namespace ugfx::sdl {
+
+    void SDLStateCache::Attach(SDL_Renderer* renderer, FrameStats* stats) {
+        m_Renderer = renderer;
+        m_Stats    = stats;
+        Invalidate();
+        ForgetAllTextures();
+    }
+
+    void SDLStateCache::Invalidate() {
+        m_DrawColorValid = false;
+        m_DrawBlendValid = false;
+        m_TargetValid    = false;
+        m_ClipValid      = false;
+    }
+
+    void SDLStateCache::ForgetTexture(SDL_Texture* texture) {
+        m_TextureStates.erase(texture);
+    }
+
+    void SDLStateCache::ForgetAllTextures() {
+        m_TextureStates.clear();
+    }
+
+    void SDLStateCache::SetDrawColor(Color color) {
+        bool same = m_DrawColorValid && m_DrawColor.r == color.r && m_DrawColor.g == color.g &&
+                    m_DrawColor.b == color.b && m_DrawColor.a == color.a;
+        if (!Changed(!same))
+            return;
+
+        SDL_SetRenderDrawColor(m_Renderer, color.r, color.g, color.b, color.a);
+        m_DrawColor      = color;
+        m_DrawColorValid = true;
+    }
+
+    void SDLStateCache::SetDrawBlendMode(SDL_BlendMode mode) {
+        if (!Changed(!m_DrawBlendValid || m_DrawBlendMode != mode))
+            return;
+
+        SDL_SetRenderDrawBlendMode(m_Renderer, mode);
+        m_DrawBlendMode  = mode;
+        m_DrawBlendValid = true;
+    }
+
+    void SDLStateCache::SetTarget(SDL_Texture* target) {
+        if (!Changed(!m_TargetValid || m_Target != target))
+            return;
+
+        SDL_SetRenderTarget(m_Renderer, target);
+        m_Target      = target;
+        m_TargetValid = true;
+        // SDL resets the clip rect and viewport when the target changes
+        m_ClipValid = false;
+    }
+
+    void SDLStateCache::SetClipRect(const SDL_Rect* rect) {
+        bool same = m_ClipValid && m_ClipEnabled == (rect != nullptr) &&
+                    (!rect || (m_ClipRect.x == rect->x && m_ClipRect.y == rect->y && m_ClipRect.w == rect->w &&
+                               m_ClipRect.h == rect->h));
+        if (!Changed(!same))
+            return;
+
+        SDL_RenderSetClipRect(m_Renderer, rect);
+        m_ClipEnabled = rect != nullptr;
+        if (rect)
+            m_ClipRect = *rect;
+        m_ClipValid = true;
+    }
+
+    void SDLStateCache::SetTextureMod(SDL_Texture* texture, Color tint) {
+        TextureState& state = m_TextureStates[texture];
+
+        bool colorSame = state.modValid && state.mod.r == tint.r && state.mod.g == tint.g && state.mod.b == tint.b;
+        if (Changed(!colorSame))
+            SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+
+        if (Changed(!state.modValid || state.mod.a != tint.a))
+            SDL_SetTextureAlphaMod(texture, tint.a);
+
+        state.mod      = tint;
+        state.modValid = true;
+    }
+
+    void SDLStateCache::SetTextureBlendMode(SDL_Texture* texture, SDL_BlendMode mode) {
+        TextureState& state = m_TextureStates[texture];
+        if (!Changed(!state.blendValid || state.blendMode != mode))
+            return;
+
+        SDL_SetTextureBlendMode(texture, mode);
+        state.blendMode  = mode;
+        state.blendValid = true;
+    }
+
+}  // namespace ugfx::sdl
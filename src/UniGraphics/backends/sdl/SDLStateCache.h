@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <unordered_map>
+
+#include "UniGraphics.h"
+
+namespace ugfx::sdl {
+
+    // Shadow copy of the SDL_Renderer state. Each setter only reaches SDL when the value differs from the last
+    // one applied, so redundant state commands never enter SDL's render batch.
+    class SDLStateCache {
+       public:
+        void Attach(SDL_Renderer* renderer, FrameStats* stats);
+
+        // Forget renderer-level state, e.g. after something outside the cache touched the SDL_Renderer.
+        void Invalidate();
+        void ForgetTexture(SDL_Texture* texture);
+        void ForgetAllTextures();
+
+        void SetDrawColor(Color color);
+        void SetDrawBlendMode(SDL_BlendMode mode);
+        void SetTarget(SDL_Texture* target);
+        void SetClipRect(const SDL_Rect* rect);  // nullptr disables clipping
+
+        void SetTextureMod(SDL_Texture* texture, Color tint);
+        void SetTextureBlendMode(SDL_Texture* texture, SDL_BlendMode mode);
+
+       private:
+        struct TextureState {
+            Color         mod        = {255, 255, 255, 255};
+            SDL_BlendMode blendMode  = SDL_BLENDMODE_BLEND;
+            bool          modValid   = false;
+            bool          blendValid = false;
+        };
+
+        bool Changed(bool changed) {
+            if (changed)
+                ++m_Stats->stateChanges;
+            else
+                ++m_Stats->stateChangesElided;
+            return changed;
+        }
+
+        SDL_Renderer* m_Renderer = nullptr;
+        FrameStats*   m_Stats    = nullptr;
+
+        Color         m_DrawColor      = {0, 0, 0, 0};
+        SDL_BlendMode m_DrawBlendMode  = SDL_BLENDMODE_NONE;
+        SDL_Texture*  m_Target         = nullptr;
+        SDL_Rect      m_ClipRect       = {0, 0, 0, 0};
+        bool          m_ClipEnabled    = false;
+        bool          m_DrawColorValid = false;
+        bool          m_DrawBlendValid = false;
+        bool          m_TargetValid    = false;
+        bool          m_ClipValid      = false;
+
+        std::unordered_map<SDL_Texture*, TextureState> m_TextureStates;
+    };
+
+}  // namespace ugfx::sdl
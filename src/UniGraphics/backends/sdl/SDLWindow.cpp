@@ -1,13 +1,16 @@
 #include "SDLWindow.h"
 
-namespace ugfx::sdl {
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+#include "SDLRenderer.h"
 
-    // SDLWindow::SDLWindow() {
-    // }
+namespace ugfx::sdl {
 
-    SDLWindow::SDLWindow(IInput* input) {
-        m_Window = SDL_CreateWindow("", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 10, 10, 0);
-        m_Input  = input;
+    SDLWindow::SDLWindow(IInput* input, SDLRenderer* renderer, FrameStats* stats)
+        : m_Input(input), m_Renderer(renderer), m_Stats(stats) {
+        m_WakeEvent = SDL_RegisterEvents(1);
     }
 
     SDLWindow::~SDLWindow() {
@@ -31,6 +34,11 @@ namespace ugfx::sdl {
         if (HasFlag(flags, WindowFlags::AlwaysOnTop))
             sdlFlags |= SDL_WINDOW_ALWAYS_ON_TOP;
 
+        if (HasFlag(flags, WindowFlags::AdaptiveVSync))
+            SetVSync(VSyncMode::Adaptive);
+        else if (HasFlag(flags, WindowFlags::VSync))
+            SetVSync(VSyncMode::On);
+
         // If window exists, update or recreate
         if (m_Window) {
             SDL_SetWindowTitle(m_Window, title.c_str());
@@ -48,10 +56,19 @@ namespace ugfx::sdl {
             return true;
         }
 
+        const auto start = std::chrono::steady_clock::now();
         m_Window =
             SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, sdlFlags);
+        if (!m_Window) {
+            std::cerr << "SDL_CreateWindow failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        if (m_Stats)
+            m_Stats->startup.windowCreate = MillisecondsSince(start);
+
         m_LastFrameTime = SDL_GetTicks();
-        return m_Window != nullptr;
+        m_ActivityDirty = true;  // read the initial state on the first PollEvents
+        return !m_Renderer || m_Renderer->Attach(m_Window);
     }
 
     void SDLWindow::SetTitle(const std::string& title) {
@@ -67,22 +84,72 @@ namespace ugfx::sdl {
         return m_ShouldClose;
     }
 
+    bool SDLWindow::HandleEvent(SDL_Event& event) {
+        if (event.type == m_WakeEvent) {
+            m_WakePending = false;
+            return false;
+        }
+
+        if (event.type == SDL_QUIT)
+            m_ShouldClose = true;
+
+        if (event.type == SDL_WINDOWEVENT) {
+            switch (event.window.event) {
+                case SDL_WINDOWEVENT_SIZE_CHANGED:
+                    m_CachedWidth  = event.window.data1;
+                    m_CachedHeight = event.window.data2;
+                    break;
+                case SDL_WINDOWEVENT_SHOWN:
+                case SDL_WINDOWEVENT_HIDDEN:
+                case SDL_WINDOWEVENT_MINIMIZED:
+                case SDL_WINDOWEVENT_MAXIMIZED:
+                case SDL_WINDOWEVENT_RESTORED:
+                case SDL_WINDOWEVENT_FOCUS_GAINED:
+                case SDL_WINDOWEVENT_FOCUS_LOST:
+                    m_ActivityDirty = true;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        m_Input->ProcessEvents(&event);
+        return true;
+    }
+
     void SDLWindow::PollEvents() {
+        // m_NeedsRedraw still says whether the previous frame was rendered, and so has pacing to do
+        if (m_LateLatch && m_NeedsRedraw)
+            WaitForLatch();
+
         m_Input->BeginFrame();
 
+        bool      hadEvents = false;
         SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT)
-                m_ShouldClose = true;
-
-            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
-                m_CachedWidth  = event.window.data1;
-                m_CachedHeight = event.window.data2;
-            }
+        if (m_WaitEvents) {
+            // Block until something happens unless a frame is already due
+            const int timeout = m_Redraw.WaitTimeout(SDL_GetTicks64());
+            if (timeout != 0 && (timeout < 0 ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, timeout)))
+                hadEvents |= HandleEvent(event);
+        }
+        while (SDL_PollEvent(&event))
+            hadEvents |= HandleEvent(event);
+        UpdateActivity();
 
-            m_Input->ProcessEvents(&event);
+        // A stopped frame rate blocks here until the window is active again
+        while (m_Governor.Stopped() && !m_ShouldClose && SDL_WaitEvent(&event)) {
+            hadEvents |= HandleEvent(event);
+            UpdateActivity();
         }
 
+        m_Input->EndFrame();
+
+        m_NeedsRedraw = !m_WaitEvents || m_Redraw.Update(SDL_GetTicks64(), hadEvents);
+        if (m_NeedsRedraw && !m_LateLatch)
+            LimitFrameRate();
+    }
+
+    void SDLWindow::LimitFrameRate() {
         if (m_TargetFrameTime > 0.0f) {
             Uint32 currentTime = SDL_GetTicks();
             float  elapsed     = (currentTime - m_LastFrameTime) / 1000.0f;
@@ -93,6 +160,81 @@ namespace ugfx::sdl {
         }
     }
 
+    // Late latch pacing for the frame about to start: the frame cap first, then the vsync slack of recent frames
+    void SDLWindow::WaitForLatch() {
+        LimitFrameRate();
+        if (!m_Stats)
+            return;
+        m_Latch.Record(m_Stats->presentWaitMs);
+        const float delay     = m_Latch.NextDelayMs();
+        m_Stats->latchDelayMs = delay;
+        if (delay >= 1.0f)
+            SDL_Delay(static_cast<Uint32>(delay));
+    }
+
+    void SDLWindow::SetLateLatch(bool enabled) {
+        m_LateLatch = enabled;
+        m_Latch.Reset();
+        if (m_Stats)
+            m_Stats->latchDelayMs = 0.0f;
+    }
+
+    void SDLWindow::UpdateActivity() {
+        if (!m_ActivityDirty || !m_Window)
+            return;
+        m_ActivityDirty = false;
+
+        // Flags rather than the event sequence: a restore can arrive without a focus event and vice versa
+        const Uint32   flags    = SDL_GetWindowFlags(m_Window);
+        WindowActivity activity = WindowActivity::Unfocused;
+        if (flags & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN))
+            activity = WindowActivity::Minimized;
+        else if (flags & SDL_WINDOW_INPUT_FOCUS)
+            activity = WindowActivity::Focused;
+
+        if (m_Governor.Update(activity, m_Stats)) {
+            ApplyFrameRate();
+            m_Redraw.Request();
+        }
+    }
+
+    void SDLWindow::ApplyFrameRate() {
+        const int fps     = m_Governor.TargetFps();
+        m_TargetFrameTime = fps > 0 ? 1.0f / fps : 0.0f;
+        if (m_Stats)
+            m_Stats->targetFps = fps > 0 ? fps : 0;
+    }
+
+    void SDLWindow::SetFrameRatePolicy(const FrameRatePolicy& policy) {
+        m_Governor.SetPolicy(policy);
+        ApplyFrameRate();
+    }
+
+    void SDLWindow::RegisterActivityCallback(ActivityCallback callback) {
+        m_Governor.AddCallback(std::move(callback));
+    }
+
+    void SDLWindow::SetWaitEvents(bool enabled) {
+        m_WaitEvents  = enabled;
+        m_NeedsRedraw = true;
+        m_Redraw.Request();
+    }
+
+    void SDLWindow::RequestRedraw(uint32_t delayMs) {
+        if (delayMs == 0)
+            m_Redraw.Request();
+        else
+            m_Redraw.RequestAt(SDL_GetTicks64() + delayMs);
+
+        // A new timer can be earlier than the one PollEvents is waiting for, so wake it either way
+        if (!m_WaitEvents || m_WakeEvent == static_cast<Uint32>(-1) || m_WakePending.exchange(true))
+            return;
+        SDL_Event wake = {};
+        wake.type      = m_WakeEvent;
+        if (SDL_PushEvent(&wake) < 1)
+            m_WakePending = false;
+    }
+
     void SDLWindow::Shutdown() {
         if (m_Window) {
             SDL_DestroyWindow(m_Window);
@@ -101,11 +243,13 @@ namespace ugfx::sdl {
     }
 
     void SDLWindow::SetTargetFPS(int fps) {
-        if (fps > 0) {
-            m_TargetFrameTime = 1.0f / fps;
-        } else {
-            m_TargetFrameTime = 0.0f;
-        }
+        m_Governor.SetBaseFps(fps);
+        ApplyFrameRate();
+    }
+
+    void SDLWindow::SetVSync(VSyncMode mode) {
+        if (m_Renderer)
+            m_Renderer->SetVSync(mode);
     }
 
     float SDLWindow::GetDeltaTime() const {
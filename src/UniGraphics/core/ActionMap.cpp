@@ -0,0 +1,85 @@
+#include "ActionMap.h"
+
+#include <algorithm>
+
+namespace ugfx {
+
+    bool ActionMap::Add(const Binding& binding) {
+        if (binding.action >= ActionState::kMaxActions)
+            return false;
+        m_Bindings.push_back(binding);
+        return true;
+    }
+
+    bool ActionMap::Bind(ActionId action, Key key) {
+        return Add({Source::Key, action, 0, static_cast<uint16_t>(key)});
+    }
+
+    bool ActionMap::Bind(ActionId action, MouseButton button) {
+        return Add({Source::Mouse, action, 0, static_cast<uint16_t>(button)});
+    }
+
+    bool ActionMap::Bind(ActionId action, GamepadButton button, int gamepad) {
+        if (gamepad < 0 || gamepad >= InputSnapshot::kGamepads)
+            return false;
+        return Add({Source::GamepadButton, action, static_cast<uint8_t>(gamepad), static_cast<uint16_t>(button)});
+    }
+
+    bool ActionMap::BindAxis(ActionId action, GamepadAxis axis, float scale, float deadZone, int gamepad) {
+        if (gamepad < 0 || gamepad >= InputSnapshot::kGamepads)
+            return false;
+        return Add(
+            {Source::GamepadAxis, action, static_cast<uint8_t>(gamepad), static_cast<uint16_t>(axis), scale, deadZone});
+    }
+
+    void ActionMap::Unbind(ActionId action) {
+        std::erase_if(m_Bindings, [action](const Binding& b) { return b.action == action; });
+    }
+
+    void ActionMap::Clear() {
+        m_Bindings.clear();
+        m_WasDown.reset();
+    }
+
+    void ActionMap::Resolve(InputSnapshot& snapshot) {
+        ActionState& state = snapshot.actions;
+        state.down.reset();
+        state.value.fill(0.0f);
+
+        std::bitset<ActionState::kMaxActions> tapped;  // pressed during the frame, possibly released again
+        for (const Binding& b : m_Bindings) {
+            float value = 0.0f;
+            switch (b.source) {
+                case Source::Key:
+                    value = snapshot.IsKeyDown(static_cast<Key>(b.code)) ? 1.0f : 0.0f;
+                    if (snapshot.IsKeyPressed(static_cast<Key>(b.code)))
+                        tapped.set(b.action);
+                    break;
+                case Source::Mouse:
+                    value = snapshot.IsMouseButtonDown(static_cast<MouseButton>(b.code)) ? 1.0f : 0.0f;
+                    if (snapshot.IsMouseButtonPressed(static_cast<MouseButton>(b.code)))
+                        tapped.set(b.action);
+                    break;
+                case Source::GamepadButton:
+                    value = snapshot.IsGamepadButtonDown(b.gamepad, static_cast<GamepadButton>(b.code)) ? 1.0f : 0.0f;
+                    if (snapshot.IsGamepadButtonPressed(b.gamepad, static_cast<GamepadButton>(b.code)))
+                        tapped.set(b.action);
+                    break;
+                case Source::GamepadAxis:
+                    value = snapshot.GetGamepadAxis(b.gamepad, static_cast<GamepadAxis>(b.code)) * b.scale;
+                    if (value <= b.deadZone)
+                        value = 0.0f;
+                    break;
+            }
+            if (value > 0.0f) {
+                state.down.set(b.action);
+                state.value[b.action] = std::max(state.value[b.action], value);
+            }
+        }
+
+        state.pressed  = (state.down | tapped) & ~m_WasDown;
+        state.released = (m_WasDown | tapped) & ~state.down;
+        m_WasDown      = state.down;
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "InputSnapshot.h"
+
+namespace ugfx {
+
+    // Bindings from application actions to keys, mouse buttons and gamepad controls. Resolve evaluates all of
+    // them in one pass over a flat list once per frame and writes the result into the snapshot, so gameplay code
+    // asks for an action instead of checking each of its keys. An action is down while any binding is active;
+    // pressed and released are edges of the action itself, not of its bindings, and a key or button tapped within
+    // one frame reports both.
+    class ActionMap {
+       public:
+        // All return false for an action past ActionState::kMaxActions
+        bool Bind(ActionId action, Key key);
+        bool Bind(ActionId action, MouseButton button);
+        bool Bind(ActionId action, GamepadButton button, int gamepad = 0);
+        // Active while axis * scale exceeds deadZone; a negative scale binds the negative direction
+        bool BindAxis(ActionId action, GamepadAxis axis, float scale = 1.0f, float deadZone = 0.25f, int gamepad = 0);
+
+        void Unbind(ActionId action);
+        void Clear();
+
+        void Resolve(InputSnapshot& snapshot);
+
+       private:
+        enum class Source : uint8_t { Key, Mouse, GamepadButton, GamepadAxis };
+
+        struct Binding {
+            Source   source;
+            ActionId action;
+            uint8_t  gamepad;
+            uint16_t code;  // Key, MouseButton, GamepadButton or GamepadAxis value
+            float    scale    = 1.0f;
+            float    deadZone = 0.0f;
+        };
+
+        bool Add(const Binding& binding);
+
+        std::vector<Binding>                  m_Bindings;
+        std::bitset<ActionState::kMaxActions> m_WasDown;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,214 @@
+#include "BitmapFont.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+#include "Utf8.h"
+
+namespace ugfx {
+
+    namespace {
+
+        // One line of a text .fnt file: a tag followed by key=value pairs, values optionally quoted
+        struct FntLine {
+            std::string_view                                            tag;
+            std::vector<std::pair<std::string_view, std::string_view>> pairs;
+
+            std::string_view Get(std::string_view key) const {
+                for (const auto& [k, v] : pairs)
+                    if (k == key)
+                        return v;
+                return {};
+            }
+
+            int Int(std::string_view key) const {
+                std::string_view value  = Get(key);
+                int              result = 0;
+                std::from_chars(value.data(), value.data() + value.size(), result);
+                return result;
+            }
+        };
+
+        void SplitLine(std::string_view line, FntLine& out) {
+            out.tag = {};
+            out.pairs.clear();
+
+            size_t i = 0;
+
+            auto skipSpaces = [&] {
+                while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r'))
+                    ++i;
+            };
+            skipSpaces();
+            size_t start = i;
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t')
+                ++i;
+            out.tag = line.substr(start, i - start);
+
+            while (true) {
+                skipSpaces();
+                if (i >= line.size())
+                    break;
+                start = i;
+                while (i < line.size() && line[i] != '=' && line[i] != ' ')
+                    ++i;
+                std::string_view key = line.substr(start, i - start);
+                if (i >= line.size() || line[i] != '=')
+                    continue;  // bare word, ignore
+                ++i;
+
+                std::string_view value;
+                if (i < line.size() && line[i] == '"') {
+                    start = ++i;
+                    while (i < line.size() && line[i] != '"')
+                        ++i;
+                    value = line.substr(start, i - start);
+                    ++i;
+                } else {
+                    start = i;
+                    while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r')
+                        ++i;
+                    value = line.substr(start, i - start);
+                }
+                out.pairs.emplace_back(key, value);
+            }
+        }
+
+    }  // namespace
+
+    bool BitmapFont::Parse(std::string_view descriptor) {
+        FntLine line;
+        int     pageCount = 0;
+        for (size_t start = 0; start < descriptor.size();) {
+            size_t end = descriptor.find('\n', start);
+            if (end == std::string_view::npos)
+                end = descriptor.size();
+            SplitLine(descriptor.substr(start, end - start), line);
+            start = end + 1;
+
+            if (line.tag == "info") {
+                m_Size = std::abs(line.Int("size"));  // negative sizes mean "match character height"
+            } else if (line.tag == "common") {
+                m_LineHeight = static_cast<float>(line.Int("lineHeight"));
+                m_PageWidth  = static_cast<float>(line.Int("scaleW"));
+                m_PageHeight = static_cast<float>(line.Int("scaleH"));
+                pageCount    = std::max(0, line.Int("pages"));
+                m_PageFiles.assign(pageCount, {});
+            } else if (line.tag == "page") {
+                const int id = line.Int("id");
+                if (id < 0 || id >= pageCount) {
+                    std::cerr << "BitmapFont: page " << id << " outside the page count\n";
+                    return false;
+                }
+                m_PageFiles[id] = std::string(line.Get("file"));
+            } else if (line.tag == "char") {
+                const int id = line.Int("id");
+                if (id < 0)
+                    continue;
+                Glyph glyph;
+                glyph.region  = {static_cast<float>(line.Int("x")), static_cast<float>(line.Int("y")),
+                                 static_cast<float>(line.Int("width")), static_cast<float>(line.Int("height"))};
+                glyph.offsetX = static_cast<float>(line.Int("xoffset"));
+                glyph.offsetY = static_cast<float>(line.Int("yoffset"));
+                glyph.advance = static_cast<float>(line.Int("xadvance"));
+                glyph.page    = line.Int("page");
+                glyph.present = true;
+                if (glyph.page < 0 || glyph.page >= pageCount) {
+                    std::cerr << "BitmapFont: glyph " << id << " on missing page " << glyph.page << "\n";
+                    return false;
+                }
+
+                const auto cp = static_cast<uint32_t>(id);
+                (cp < m_Latin1.size() ? m_Latin1[cp] : m_Glyphs[cp]) = glyph;
+            } else if (line.tag == "kerning") {
+                const auto left  = static_cast<uint64_t>(line.Int("first"));
+                const auto right = static_cast<uint32_t>(line.Int("second"));
+
+                m_Kerning[left << 32 | right] = static_cast<float>(line.Int("amount"));
+            }
+        }
+
+        if (pageCount == 0 || m_PageWidth <= 0.0f || m_PageHeight <= 0.0f) {
+            std::cerr << "BitmapFont: missing or invalid 'common' line\n";
+            return false;
+        }
+        for (const std::string& file : m_PageFiles) {
+            if (file.empty()) {
+                std::cerr << "BitmapFont: a page has no file\n";
+                return false;
+            }
+        }
+        if (m_Size == 0)
+            m_Size = static_cast<int>(m_LineHeight);
+        return true;
+    }
+
+    const BitmapFont::Glyph* BitmapFont::Find(uint32_t codepoint) const {
+        if (codepoint < m_Latin1.size())
+            return m_Latin1[codepoint].present ? &m_Latin1[codepoint] : nullptr;
+        auto it = m_Glyphs.find(codepoint);
+        return it != m_Glyphs.end() ? &it->second : nullptr;
+    }
+
+    float BitmapFont::KerningOf(uint32_t left, uint32_t right) const {
+        if (m_Kerning.empty())
+            return 0.0f;
+        auto it = m_Kerning.find(static_cast<uint64_t>(left) << 32 | right);
+        return it != m_Kerning.end() ? it->second : 0.0f;
+    }
+
+    float BitmapFont::Advance(uint32_t codepoint) {
+        const Glyph* glyph = Find(codepoint);
+        if (!glyph)
+            glyph = Find('?');
+        return glyph ? glyph->advance : 0.0f;
+    }
+
+    float BitmapFont::Kerning(uint32_t left, uint32_t right) {
+        return KerningOf(left, right);
+    }
+
+    size_t BitmapFont::BuildQuads(std::string_view text, Vector2 pos, float scale, Color color, int page,
+                                  std::vector<Vertex2D>& out) const {
+        const size_t first = out.size();
+        const float  invW = 1.0f / m_PageWidth, invH = 1.0f / m_PageHeight;
+
+        float    penX = pos.x, penY = pos.y;
+        uint32_t prev = 0;
+        for (size_t i = 0; i < text.size();) {
+            const uint32_t cp = DecodeUtf8(text, i);
+            if (cp == '\n') {
+                penX = pos.x;
+                penY += m_LineHeight * scale;
+                prev = 0;
+                continue;
+            }
+
+            const Glyph* g = Find(cp);
+            if (!g && !(g = Find('?'))) {
+                prev = 0;
+                continue;
+            }
+            if (prev)
+                penX += KerningOf(prev, cp) * scale;
+            prev = cp;
+
+            if (g->page == page && g->region.width > 0.0f && g->region.height > 0.0f) {
+                const float x0 = penX + g->offsetX * scale, x1 = x0 + g->region.width * scale;
+                const float y0 = penY + g->offsetY * scale, y1 = y0 + g->region.height * scale;
+                const float u0 = g->region.x * invW, u1 = (g->region.x + g->region.width) * invW;
+                const float v0 = g->region.y * invH, v1 = (g->region.y + g->region.height) * invH;
+                out.push_back({{x0, y0}, color, {u0, v0}});
+                out.push_back({{x1, y0}, color, {u1, v0}});
+                out.push_back({{x0, y1}, color, {u0, v1}});
+                out.push_back({{x1, y1}, color, {u1, v1}});
+            }
+            penX += g->advance * scale;
+        }
+        return (out.size() - first) / 4;
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../CommonTypes.h"
+#include "TextLayout.h"
+
+namespace ugfx {
+
+    // Pre-baked AngelCode BMFont: glyph rectangles on one or more page images plus metrics, parsed from the text
+    // .fnt format. Drawing is pure quad expansion, so it suits HUD text that changes every frame. The renderer
+    // owns the page textures.
+    class BitmapFont : public IGlyphMetrics {
+       public:
+        // Returns false and logs on malformed input
+        bool Parse(std::string_view descriptor);
+
+        const std::vector<std::string>& PageFiles() const { return m_PageFiles; }
+        std::vector<Texture>&           Pages() { return m_Pages; }  // filled by the loader, one per page file
+
+        // Appends one quad per visible glyph on the given page (four vertices, see BuildQuadIndices) with texture
+        // coordinates normalized to that page's texture. Does not allocate once out has grown. Returns the quads
+        // added.
+        size_t BuildQuads(std::string_view text, Vector2 pos, float scale, Color color, int page,
+                          std::vector<Vertex2D>& out) const;
+
+        // IGlyphMetrics
+        int   BaseSize() const override { return m_Size; }
+        float LineHeight() const override { return m_LineHeight; }
+        float Advance(uint32_t codepoint) override;
+        float Kerning(uint32_t left, uint32_t right) override;
+
+       private:
+        struct Glyph {
+            Rectangle region  = {};  // page pixels
+            float     offsetX = 0.0f, offsetY = 0.0f;
+            float     advance = 0.0f;
+            int       page    = 0;
+            bool      present = false;
+        };
+
+        const Glyph* Find(uint32_t codepoint) const;
+        float        KerningOf(uint32_t left, uint32_t right) const;
+
+        int                      m_Size       = 0;
+        float                    m_LineHeight = 0.0f;
+        float                    m_PageWidth = 0.0f, m_PageHeight = 0.0f;
+        std::vector<std::string> m_PageFiles;
+        std::vector<Texture>     m_Pages;
+
+        std::array<Glyph, 256>              m_Latin1;
+        std::unordered_map<uint32_t, Glyph> m_Glyphs;   // beyond Latin-1
+        std::unordered_map<uint64_t, float> m_Kerning;  // by left << 32 | right
+    };
+
+}  // namespace ugfx
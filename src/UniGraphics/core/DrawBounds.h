@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+
+#include "../CommonTypes.h"
+
+namespace ugfx {
+
+    // Conservative screen-space bounds of the individual draw calls.
+
+    inline constexpr Rectangle kUnboundedRect = {-std::numeric_limits<float>::infinity(),
+                                                 -std::numeric_limits<float>::infinity(),
+                                                 std::numeric_limits<float>::infinity(),
+                                                 std::numeric_limits<float>::infinity()};
+
+    inline bool IsUnbounded(const Rectangle& r) {
+        return !(r.width < std::numeric_limits<float>::max() && r.height < std::numeric_limits<float>::max());
+    }
+
+    inline Rectangle BoundsOfPoints(Vector2 a, Vector2 b, float pad = 0.0f) {
+        float minX = std::min(a.x, b.x) - pad, minY = std::min(a.y, b.y) - pad;
+        float maxX = std::max(a.x, b.x) + pad, maxY = std::max(a.y, b.y) + pad;
+        return {minX, minY, maxX - minX, maxY - minY};
+    }
+
+    inline Rectangle BoundsOfTriangle(Vector2 a, Vector2 b, Vector2 c) {
+        float minX = std::min({a.x, b.x, c.x}), minY = std::min({a.y, b.y, c.y});
+        float maxX = std::max({a.x, b.x, c.x}), maxY = std::max({a.y, b.y, c.y});
+        return {minX, minY, maxX - minX, maxY - minY};
+    }
+
+    // A w x h quad rotated by any angle around pivot, where the quad's corners lie within the offsets covered by
+    // origin (and its mirror, for flipped draws).
+    inline Rectangle BoundsOfRotatedQuad(Vector2 pivot, Vector2 origin, float w, float h) {
+        float r = std::hypot(std::abs(w) + 2.0f * std::abs(origin.x), std::abs(h) + 2.0f * std::abs(origin.y));
+        return {pivot.x - r, pivot.y - r, 2.0f * r, 2.0f * r};
+    }
+
+    inline Rectangle BoundsOfVertices(std::span<const Vertex2D> vertices) {
+        if (vertices.empty())
+            return {0.0f, 0.0f, 0.0f, 0.0f};
+
+        float minX = vertices[0].position.x, minY = vertices[0].position.y;
+        float maxX = minX, maxY = minY;
+        for (const Vertex2D& v : vertices) {
+            minX = std::min(minX, v.position.x);
+            minY = std::min(minY, v.position.y);
+            maxX = std::max(maxX, v.position.x);
+            maxY = std::max(maxY, v.position.y);
+        }
+        return {minX, minY, maxX - minX, maxY - minY};
+    }
+
+}  // namespace ugfx
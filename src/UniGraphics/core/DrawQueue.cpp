@@ -0,0 +1,200 @@
+#include "DrawQueue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "DrawBounds.h"
+
+namespace ugfx {
+
+    void DrawQueue::Clear() {
+        m_Commands.clear();
+        m_Keys.clear();
+        m_Order.clear();
+        m_Vertices.clear();
+        m_Indices.clear();
+        m_Text.clear();
+        m_Clips.clear();
+        m_LayerIndex.clear();
+        m_GridsUsed = 0;
+        m_Overflow  = false;
+    }
+
+    uint32_t DrawQueue::Contribution(const Cell& cell, uint32_t state) {
+        if (cell.level == 0)
+            return 0;
+        return cell.level - 1u + ((cell.mixed || cell.state != state) ? 1u : 0u);
+    }
+
+    void DrawQueue::Merge(Cell& cell, uint32_t level, uint32_t state) {
+        if (level > cell.level) {
+            cell.level = static_cast<uint16_t>(level);
+            cell.state = state;
+            cell.mixed = false;
+        } else if (level == cell.level && state != cell.state) {
+            cell.mixed = true;
+        }
+    }
+
+    DrawQueue::LayerGrid& DrawQueue::GridFor(int layer) {
+        auto it = m_LayerIndex.find(layer);
+        if (it != m_LayerIndex.end())
+            return m_Grids[it->second];
+
+        uint32_t index = m_GridsUsed++;
+        if (index >= m_Grids.size()) {
+            m_Grids.emplace_back();
+            m_Grids.back().cells.resize(kGridSize);
+        } else {
+            LayerGrid& grid = m_Grids[index];
+            grid.floor      = {};
+            grid.max        = {};
+            std::fill(grid.cells.begin(), grid.cells.end(), Cell{});
+        }
+        m_LayerIndex.emplace(layer, index);
+        return m_Grids[index];
+    }
+
+    DrawCommand& DrawQueue::Push(const DrawCommand& cmd, int layer, uint32_t state, const Rectangle& bounds) {
+        const uint32_t fullState = (state & 0xFFFFFu) | ((static_cast<uint32_t>(cmd.blend) & 0x3u) << 20) |
+                                   ((static_cast<uint32_t>(cmd.clip) & 0x3FFu) << 22);
+
+        LayerGrid& grid = GridFor(layer);
+
+        // Cell range covered by the bounds; huge or unbounded draws are tracked layer-wide
+        bool global = IsUnbounded(bounds) || std::abs(bounds.x) > 1e9f || std::abs(bounds.y) > 1e9f;
+        int  x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+        if (!global) {
+            const float cell = static_cast<float>(1 << kCellShift);
+            x0               = static_cast<int>(std::floor(bounds.x / cell));
+            y0               = static_cast<int>(std::floor(bounds.y / cell));
+            x1               = static_cast<int>(std::floor((bounds.x + bounds.width) / cell));
+            y1               = static_cast<int>(std::floor((bounds.y + bounds.height) / cell));
+            global           = static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1) > kMaxCells;
+        }
+
+        auto cellAt = [&](int cx, int cy) -> Cell& {
+            uint32_t h = (static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u);
+            return grid.cells[h & (kGridSize - 1)];
+        };
+
+        uint32_t bucket = Contribution(grid.floor, fullState);
+        if (global) {
+            bucket = std::max(bucket, Contribution(grid.max, fullState));
+        } else {
+            for (int cy = y0; cy <= y1; ++cy)
+                for (int cx = x0; cx <= x1; ++cx)
+                    bucket = std::max(bucket, Contribution(cellAt(cx, cy), fullState));
+        }
+
+        if (bucket >= 0xFFFEu) {
+            m_Overflow = true;  // fall back to submission order within layers
+            bucket     = 0xFFFEu;
+        }
+
+        const uint32_t level = bucket + 1;
+        if (global) {
+            Merge(grid.floor, level, fullState);
+        } else {
+            for (int cy = y0; cy <= y1; ++cy)
+                for (int cx = x0; cx <= x1; ++cx)
+                    Merge(cellAt(cx, cy), level, fullState);
+        }
+        Merge(grid.max, level, fullState);
+
+        const uint64_t layerBits = static_cast<uint16_t>(std::clamp(layer, -32768, 32767) + 32768);
+        m_Keys.push_back((layerBits << 48) | (static_cast<uint64_t>(bucket) << 32) | fullState);
+        m_Commands.push_back(cmd);
+        return m_Commands.back();
+    }
+
+    void DrawQueue::PushVertices(DrawCommand& cmd, std::span<const Vertex2D> vertices, std::span<const int> indices) {
+        cmd.dataOffset = static_cast<uint32_t>(m_Vertices.size());
+        cmd.dataCount  = static_cast<uint32_t>(vertices.size());
+        m_Vertices.insert(m_Vertices.end(), vertices.begin(), vertices.end());
+
+        cmd.indexOffset = static_cast<uint32_t>(m_Indices.size());
+        cmd.indexCount  = static_cast<uint32_t>(indices.size());
+        m_Indices.insert(m_Indices.end(), indices.begin(), indices.end());
+    }
+
+    void DrawQueue::PushText(DrawCommand& cmd, std::string_view text) {
+        cmd.dataOffset = static_cast<uint32_t>(m_Text.size());
+        cmd.dataCount  = static_cast<uint32_t>(text.size());
+        m_Text.append(text);
+    }
+
+    uint16_t DrawQueue::PushClip(const Rectangle& rect) {
+        if (!m_Clips.empty()) {
+            const Rectangle& last = m_Clips.back();
+            if (last.x == rect.x && last.y == rect.y && last.width == rect.width && last.height == rect.height)
+                return static_cast<uint16_t>(m_Clips.size());
+        }
+        if (m_Clips.size() >= 0xFFFF)
+            return static_cast<uint16_t>(m_Clips.size());  // reuse the last slot rather than wrap
+        m_Clips.push_back(rect);
+        return static_cast<uint16_t>(m_Clips.size());
+    }
+
+    std::span<const Vertex2D> DrawQueue::Vertices(const DrawCommand& cmd) const {
+        return {m_Vertices.data() + cmd.dataOffset, cmd.dataCount};
+    }
+
+    std::span<const int> DrawQueue::Indices(const DrawCommand& cmd) const {
+        return {m_Indices.data() + cmd.indexOffset, cmd.indexCount};
+    }
+
+    std::string_view DrawQueue::Text(const DrawCommand& cmd) const {
+        return {m_Text.data() + cmd.dataOffset, cmd.dataCount};
+    }
+
+    void DrawQueue::Sort() {
+        if (m_Overflow) {
+            for (uint64_t& key : m_Keys)
+                key &= 0xFFFF000000000000ull;
+        }
+        RadixSortByKey(m_Keys, m_Order, m_KeyScratch, m_Scratch);
+    }
+
+    void RadixSortByKey(std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint64_t>& keyScratch,
+                        std::vector<uint32_t>& orderScratch) {
+        const size_t n = keys.size();
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0u);
+        if (n < 2)
+            return;
+
+        keyScratch.resize(n);
+        orderScratch.resize(n);
+
+        // All eight byte histograms in one read pass
+        uint32_t counts[8][256] = {};
+        for (uint64_t key : keys)
+            for (int pass = 0; pass < 8; ++pass)
+                ++counts[pass][(key >> (pass * 8)) & 0xFF];
+
+        for (int pass = 0; pass < 8; ++pass) {
+            const int shift = pass * 8;
+            uint32_t* count = counts[pass];
+            if (count[(keys[0] >> shift) & 0xFF] == n)
+                continue;  // every key has the same byte here
+
+            uint32_t offsets[256];
+            uint32_t sum = 0;
+            for (int i = 0; i < 256; ++i) {
+                offsets[i] = sum;
+                sum += count[i];
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                uint32_t dst      = offsets[(keys[i] >> shift) & 0xFF]++;
+                keyScratch[dst]   = keys[i];
+                orderScratch[dst] = order[i];
+            }
+            keys.swap(keyScratch);
+            order.swap(orderScratch);
+        }
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,74 @@
+#include "EmbeddedFont.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "../Lexend.h"
+
+namespace ugfx {
+
+    // LZ4 length fields continue with 255-valued bytes
+    static bool ReadLength(std::span<const uint8_t> src, size_t& i, size_t& length) {
+        uint8_t byte = 255;
+        while (byte == 255) {
+            if (i >= src.size())
+                return false;
+            byte = src[i++];
+            length += byte;
+        }
+        return true;
+    }
+
+    bool DecompressLz4(std::span<const uint8_t> src, size_t size, std::vector<uint8_t>& out) {
+        out.resize(size);
+        size_t i = 0, o = 0;
+        while (i < src.size()) {
+            const uint8_t token    = src[i++];
+            size_t        literals = token >> 4;
+            if (literals == 15 && !ReadLength(src, i, literals))
+                return false;
+            if (literals > src.size() - i || literals > size - o)
+                return false;
+            std::memcpy(out.data() + o, src.data() + i, literals);
+            i += literals;
+            o += literals;
+            if (i == src.size())
+                break;  // the last sequence has no match
+
+            if (src.size() - i < 2)
+                return false;
+            const size_t offset = src[i] | static_cast<size_t>(src[i + 1]) << 8;
+            size_t       match  = token & 15;
+            i += 2;
+            if (match == 15 && !ReadLength(src, i, match))
+                return false;
+            match += 4;
+            if (offset == 0 || offset > o || match > size - o)
+                return false;
+
+            // Overlapping matches repeat the last offset bytes, so copy forward one byte at a time
+            const uint8_t* from = out.data() + o - offset;
+            uint8_t*       to   = out.data() + o;
+            if (offset >= match)
+                std::memcpy(to, from, match);
+            else
+                for (size_t k = 0; k < match; ++k)
+                    to[k] = from[k];
+            o += match;
+        }
+        return o == size;
+    }
+
+    std::span<const uint8_t> DefaultFontData() {
+        static const std::vector<uint8_t> data = [] {
+            std::vector<uint8_t> bytes;
+            if (!DecompressLz4(Lexend_ttf_lz4, Lexend_ttf_len, bytes)) {
+                std::cerr << "Embedded default font is corrupt" << std::endl;
+                bytes.clear();
+            }
+            return bytes;
+        }();
+        return data;
+    }
+
+}  // namespace ugfx
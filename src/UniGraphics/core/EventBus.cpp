@@ -0,0 +1,76 @@
+#include "EventBus.h"
+
+#include <algorithm>
+
+namespace ugfx {
+
+    EventSubscription EventBus::Subscribe(EventMask types, EventListener listener) {
+        if (!listener || (types & ((EventMask(1) << kTypes) - 1)) == 0)
+            return {};
+        // The arrays stay untouched while a dispatch walks them
+        const uint32_t id = m_NextId++;
+        for (uint32_t t = 0; t < kTypes; ++t) {
+            if (types & (EventMask(1) << t))
+                (m_Dispatching ? m_Pending : m_Listeners[t]).push_back({id, t, listener});
+        }
+        return {id};
+    }
+
+    void EventBus::Unsubscribe(EventSubscription& subscription) {
+        if (subscription.id == 0)
+            return;
+        for (std::vector<Entry>& list : m_Listeners) {
+            for (Entry& entry : list) {
+                if (entry.id == subscription.id) {
+                    entry.id = 0;
+                    m_Dirty  = true;
+                }
+            }
+        }
+        std::erase_if(m_Pending, [&](const Entry& e) { return e.id == subscription.id; });
+        subscription.id = 0;
+        if (m_Dispatching == 0)
+            Compact();
+    }
+
+    void EventBus::Clear() {
+        for (std::vector<Entry>& list : m_Listeners)
+            for (Entry& entry : list)
+                entry.id = 0;
+        m_Pending.clear();
+        m_Dirty = true;
+        if (m_Dispatching == 0)
+            Compact();
+    }
+
+    void EventBus::Dispatch(const InputEvent& event) {
+        const auto type = static_cast<size_t>(event.type);
+        if (type >= kTypes)
+            return;
+
+        ++m_Dispatching;
+        for (Entry& entry : m_Listeners[type])
+            if (entry.id != 0)
+                entry.listener(event);
+        if (--m_Dispatching == 0 && (m_Dirty || !m_Pending.empty()))
+            Compact();
+    }
+
+    size_t EventBus::ListenerCount(InputEvent::Type type) const {
+        const auto t = static_cast<size_t>(type);
+        if (t >= kTypes)
+            return 0;
+        return static_cast<size_t>(
+            std::count_if(m_Listeners[t].begin(), m_Listeners[t].end(), [](const Entry& e) { return e.id != 0; }));
+    }
+
+    void EventBus::Compact() {
+        for (std::vector<Entry>& list : m_Listeners)
+            std::erase_if(list, [](const Entry& e) { return e.id == 0; });
+        for (const Entry& entry : m_Pending)
+            m_Listeners[entry.type].push_back(entry);
+        m_Pending.clear();
+        m_Dirty = false;
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,185 @@
+#include "FixedStepLoop.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "ActionMap.h"
+
+namespace ugfx {
+
+    namespace {
+
+        // Edges of a frame that ran no tick, moved into the next frame so no tick misses a press
+        void CarryEdges(InputSnapshot& into, const InputSnapshot& from) {
+            into.keys.pressed |= from.keys.pressed;
+            into.keys.released |= from.keys.released;
+            into.pointer.pressed |= from.pointer.pressed;
+            into.pointer.released |= from.pointer.released;
+            into.pointer.delta.x += from.pointer.delta.x;
+            into.pointer.delta.y += from.pointer.delta.y;
+            into.pointer.wheel.x += from.pointer.wheel.x;
+            into.pointer.wheel.y += from.pointer.wheel.y;
+            for (size_t i = 0; i < into.gamepads.size(); ++i) {
+                into.gamepads[i].pressed |= from.gamepads[i].pressed;
+                into.gamepads[i].released |= from.gamepads[i].released;
+            }
+            into.actions.pressed |= from.actions.pressed;
+            into.actions.released |= from.actions.released;
+        }
+
+        void ClearEdges(InputSnapshot& input) {
+            input.keys.BeginFrame();
+            input.pointer.BeginFrame();
+            for (GamepadSnapshot& pad : input.gamepads) {
+                pad.pressed.reset();
+                pad.released.reset();
+            }
+            input.actions.pressed.reset();
+            input.actions.released.reset();
+        }
+
+    }  // namespace
+
+    FixedStepLoop::FixedStepLoop(IGraphicsBackend& backend, FixedStepCallbacks callbacks,
+                                 const FixedStepSettings& settings)
+        : m_Backend(backend), m_Callbacks(std::move(callbacks)), m_Settings(settings) {
+        m_Settings.tickRate = std::max(1, m_Settings.tickRate);
+        m_Settings.maxTicks = std::max(1, m_Settings.maxTicks);
+        m_Dt                = 1.0 / m_Settings.tickRate;
+        m_Last              = std::chrono::steady_clock::now();
+    }
+
+    FixedStepLoop::~FixedStepLoop() {
+        if (!m_Worker.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Quit = true;
+        }
+        m_Wake.notify_all();
+        m_Worker.join();
+    }
+
+    void FixedStepLoop::Reset() {
+        m_Last        = std::chrono::steady_clock::now();
+        m_Accumulator = 0.0;
+        m_Alpha       = 0.0f;
+    }
+
+    bool FixedStepLoop::Step() {
+        IWindow*   window   = m_Backend.GetWindow();
+        IInput*    input    = m_Backend.GetInput();
+        IRenderer* renderer = m_Backend.GetRenderer();
+        if (m_Stopped || !window || !input || !renderer || window->ShouldClose())
+            return false;
+
+        window->PollEvents();
+
+        const auto   now     = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - m_Last).count();
+        m_Last               = now;
+        m_Accumulator += std::min(elapsed, m_Settings.maxFrameMs / 1000.0);
+
+        // Spiral-of-death protection: a frame never runs more than maxTicks, the ticks it could not fit are dropped
+        FrameStats& stats = m_Backend.GetFrameStats();
+        int         ticks = static_cast<int>(m_Accumulator / m_Dt);
+        m_Accumulator -= ticks * m_Dt;
+        if (ticks > m_Settings.maxTicks) {
+            stats.simTicksDropped += static_cast<uint32_t>(ticks - m_Settings.maxTicks);
+            ticks = m_Settings.maxTicks;
+        }
+        const float alpha = static_cast<float>(m_Accumulator / m_Dt);
+
+        // The worker is idle here, the previous frame waited for it
+        InputSnapshot frame;
+        input->Snapshot(frame);
+        if (m_Actions)
+            m_Actions->Resolve(frame);
+        if (!m_EdgesUsed)
+            CarryEdges(frame, m_Input);
+        m_Input        = frame;
+        m_PendingTicks = ticks;
+        m_EdgesUsed    = ticks > 0;
+        m_UpdateMs     = 0.0;
+
+        const bool pipelined = m_Settings.pipelined && ticks > 0;
+        if (pipelined) {
+            if (!m_Worker.joinable())
+                m_Worker = std::thread([this] { WorkerLoop(); });
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Busy = true;
+            }
+            m_Wake.notify_one();
+        } else if (!m_Settings.pipelined) {
+            RunTicks();
+            if (ticks > 0 && m_Callbacks.publish)
+                m_Callbacks.publish();
+            m_Alpha = alpha;
+        }
+
+        double renderMs = 0.0;
+        if (window->NeedsRedraw()) {
+            const auto start = std::chrono::steady_clock::now();
+            renderer->BeginDrawing();
+            if (m_Callbacks.render)
+                m_Callbacks.render(*renderer, m_Alpha);
+            renderer->EndDrawing();
+            renderMs = MillisecondsSince(start);
+        }
+
+        double waitMs = 0.0;
+        if (pipelined) {
+            const auto start = std::chrono::steady_clock::now();
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Done.wait(lock, [this] { return !m_Busy; });
+            }
+            waitMs = MillisecondsSince(start);
+            if (m_Callbacks.publish)
+                m_Callbacks.publish();
+        }
+        if (m_Settings.pipelined)
+            m_Alpha = alpha;  // rendered next frame, together with the ticks just published
+
+        m_Ticks += static_cast<uint64_t>(ticks);
+        stats.updateMs           = static_cast<float>(m_UpdateMs);
+        stats.renderMs           = static_cast<float>(renderMs);
+        stats.waitMs             = static_cast<float>(waitMs);
+        stats.simTicks           = static_cast<uint32_t>(ticks);
+        stats.interpolationAlpha = m_Alpha;
+        return true;
+    }
+
+    void FixedStepLoop::RunTicks() {
+        if (m_PendingTicks == 0 || !m_Callbacks.update)
+            return;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < m_PendingTicks; ++i) {
+            if (i == 1)
+                ClearEdges(m_Input);
+            m_Callbacks.update(m_Input, m_Dt);
+        }
+        m_UpdateMs = MillisecondsSince(start);
+    }
+
+    void FixedStepLoop::WorkerLoop() {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Wake.wait(lock, [this] { return m_Quit || m_Busy; });
+                if (m_Quit)
+                    return;
+            }
+
+            RunTicks();
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Busy = false;
+            }
+            m_Done.notify_one();
+        }
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "../interfaces/IGraphicsBackend.h"
+#include "InputSnapshot.h"
+
+namespace ugfx {
+
+    class ActionMap;
+
+    struct FixedStepSettings {
+        int   tickRate   = 60;      // simulation ticks per second
+        int   maxTicks   = 5;       // per frame; whole ticks beyond it are dropped instead of caught up
+        float maxFrameMs = 250.0f;  // real time one frame may add, so a stall or a breakpoint is not replayed
+        bool  pipelined  = false;   // simulate on a worker while the previous ticks render
+    };
+
+    struct FixedStepCallbacks {
+        // One simulation tick of dt seconds. Frame input goes to the first tick of a frame only; later ticks of the
+        // same frame see the held state without edges. Runs on the loop's worker when pipelined, so it must not
+        // touch the window, input or renderer.
+        std::function<void(const InputSnapshot& input, double dt)> update;
+        // On the calling thread once the ticks of a frame are done and the worker is idle: copy simulation state
+        // into render state here. Optional without pipelining.
+        std::function<void()> publish;
+        // Between BeginDrawing and EndDrawing; alpha in [0, 1) blends the last two published ticks
+        std::function<void(IRenderer& renderer, float alpha)> render;
+    };
+
+    // Application loop with a fixed simulation rate. Each frame adds the real time elapsed to an accumulator and
+    // runs as many whole ticks as it holds, then renders with the remainder as interpolation alpha. Pipelined,
+    // the ticks of frame N run on a worker while frame N renders what N-1 published, at one frame of latency.
+    class FixedStepLoop {
+       public:
+        FixedStepLoop(IGraphicsBackend& backend, FixedStepCallbacks callbacks, const FixedStepSettings& settings = {});
+        ~FixedStepLoop();
+
+        FixedStepLoop(const FixedStepLoop&)            = delete;
+        FixedStepLoop& operator=(const FixedStepLoop&) = delete;
+
+        void SetActionMap(ActionMap* actions) { m_Actions = actions; }
+
+        // One frame: events, ticks, render. Returns false once the window should close or Stop was called.
+        bool Step();
+        void Run() {
+            while (Step()) {
+            }
+        }
+        void Stop() { m_Stopped = true; }  // also from the update callback
+
+        // Restarts the clock and empties the accumulator, e.g. after a long load
+        void Reset();
+
+        uint64_t Ticks() const { return m_Ticks; }
+        double   TickSeconds() const { return m_Dt; }
+
+       private:
+        void RunTicks();
+        void WorkerLoop();
+
+        IGraphicsBackend&  m_Backend;
+        FixedStepCallbacks m_Callbacks;
+        FixedStepSettings  m_Settings;
+        ActionMap*         m_Actions = nullptr;
+
+        std::chrono::steady_clock::time_point m_Last;
+        double                                m_Dt          = 0.0;
+        double                                m_Accumulator = 0.0;
+        uint64_t                              m_Ticks       = 0;
+        float                                 m_Alpha       = 0.0f;  // of the last published ticks
+        bool                                  m_EdgesUsed   = true;  // frame input reached a tick
+        std::atomic<bool>                     m_Stopped     = false;
+
+        // Ticks handed to RunTicks: the frame input and how many to run. Owned by the worker while it is busy.
+        InputSnapshot m_Input;
+        int           m_PendingTicks = 0;
+        double        m_UpdateMs     = 0.0;
+
+        std::thread             m_Worker;
+        std::mutex              m_Mutex;
+        std::condition_variable m_Wake;
+        std::condition_variable m_Done;
+        bool                    m_Busy = false;
+        bool                    m_Quit = false;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../FrameStats.h"
+#include "../interfaces/IWindow.h"
+
+namespace ugfx {
+
+    // Picks the frame rate cap for the current window activity and reports activity transitions. Backends feed it
+    // the activity they observe and apply TargetFps() to their frame limiter.
+    class FrameRateGovernor {
+       public:
+        void SetPolicy(const FrameRatePolicy& policy) { m_Policy = policy; }
+        void SetBaseFps(int fps) { m_BaseFps = fps > 0 ? fps : 0; }
+        void AddCallback(IWindow::ActivityCallback callback) { m_Callbacks.push_back(std::move(callback)); }
+
+        WindowActivity Activity() const { return m_Activity; }
+
+        // 0 when rendering is stopped, otherwise the cap with -1 for uncapped
+        int TargetFps() const {
+            const int fps = m_Activity == WindowActivity::Focused     ? m_Policy.focused
+                            : m_Activity == WindowActivity::Unfocused ? m_Policy.unfocused
+                                                                      : m_Policy.minimized;
+            if (fps >= 0)
+                return fps;
+            return m_BaseFps > 0 ? m_BaseFps : -1;
+        }
+        bool Stopped() const { return TargetFps() == 0; }
+
+        // Returns true on a transition, after recording it and notifying the callbacks
+        bool Update(WindowActivity activity, FrameStats* stats) {
+            if (activity == m_Activity)
+                return false;
+            const WindowActivity previous = m_Activity;
+            m_Activity                    = activity;
+            if (stats) {
+                stats->activity = activity;
+                ++stats->activityChanges;
+            }
+            for (const auto& cb : m_Callbacks)
+                cb(previous, activity);
+            return true;
+        }
+
+       private:
+        FrameRatePolicy                        m_Policy;
+        WindowActivity                         m_Activity = WindowActivity::Focused;
+        int                                    m_BaseFps  = 0;
+        std::vector<IWindow::ActivityCallback> m_Callbacks;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,232 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+#include "SdfGenerator.h"
+#include "Utf8.h"
+
+namespace ugfx {
+
+    static constexpr int    kInitialAtlasHeight = 256;
+    static constexpr int    kMaxAtlasHeight     = 4096;
+    static constexpr size_t kMaxRuns            = 2048;  // shaped lines kept; the least recent half goes when full
+
+    GlyphAtlas::GlyphAtlas(std::unique_ptr<IGlyphSource> source, int spread, int width)
+        : m_Spread(spread), m_Width(width), m_Height(kInitialAtlasHeight) {
+        m_Sources.push_back(std::move(source));
+        m_Pixels.assign(static_cast<size_t>(m_Width) * m_Height, 0);
+    }
+
+    void GlyphAtlas::AddFallback(std::unique_ptr<IGlyphSource> source) {
+        if (!source || m_Sources.size() >= 255)
+            return;
+        m_Sources.push_back(std::move(source));
+
+        // Code points that fell back to '?' get another chance; cached runs may point at them
+        for (Glyph& glyph : m_Ascii)
+            if (glyph.missing)
+                glyph = {};
+        for (auto& [cp, glyph] : m_Glyphs)
+            if (glyph.missing)
+                glyph = {};
+        m_Runs.clear();
+    }
+
+    const GlyphAtlas::Glyph& GlyphAtlas::Find(uint32_t codepoint) {
+        Glyph& glyph = codepoint < m_Ascii.size() ? m_Ascii[codepoint] : m_Glyphs[codepoint];
+        if (glyph.loaded)
+            return glyph;
+
+        glyph.loaded = true;
+        for (size_t s = 0; s < m_Sources.size(); ++s) {
+            m_Bitmap = {};
+            if (m_Sources[s]->Rasterize(codepoint, m_Bitmap)) {
+                Store(static_cast<uint8_t>(s), glyph);
+                return glyph;
+            }
+        }
+
+        if (codepoint != '?') {
+            glyph         = Find('?');
+            glyph.missing = true;
+        }
+        return glyph;
+    }
+
+    const GlyphAtlas::Glyph& GlyphAtlas::FindShaped(uint32_t glyphIndex) {
+        Glyph& glyph = m_Shaped[glyphIndex];
+        if (!glyph.loaded) {
+            glyph.loaded = true;
+            m_Bitmap     = {};
+            if (m_Sources[0]->RasterizeGlyph(glyphIndex, m_Bitmap))
+                Store(0, glyph);
+        }
+        return glyph;
+    }
+
+    // Packs m_Bitmap, just produced by the given source, into the atlas
+    void GlyphAtlas::Store(uint8_t source, Glyph& glyph) {
+        glyph.source  = source;
+        glyph.advance = m_Bitmap.advance;
+        glyph.offsetX = static_cast<float>(m_Bitmap.offsetX - m_Spread);
+        glyph.offsetY = static_cast<float>(m_Bitmap.offsetY - m_Spread);
+        if (m_Bitmap.width <= 0 || m_Bitmap.height <= 0)
+            return;  // whitespace
+
+        // Pad by the spread so the field can fall off fully outside the outline
+        const int w = m_Bitmap.width + 2 * m_Spread;
+        const int h = m_Bitmap.height + 2 * m_Spread;
+        m_Padded.assign(static_cast<size_t>(w) * h, 0);
+        for (int y = 0; y < m_Bitmap.height; ++y)
+            std::memcpy(&m_Padded[(y + m_Spread) * w + m_Spread], &m_Bitmap.coverage[y * m_Bitmap.width],
+                        m_Bitmap.width);
+        GenerateSdf(m_Padded, w, h, static_cast<float>(m_Spread), m_Field);
+
+        int x = 0, y = 0;
+        if (!Allocate(w, h, x, y)) {
+            std::cerr << "GlyphAtlas: atlas full, dropping a glyph\n";
+            return;
+        }
+        for (int row = 0; row < h; ++row)
+            std::memcpy(&m_Pixels[(y + row) * m_Width + x], &m_Field[row * w], w);
+
+        glyph.region = {static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)};
+        ++m_Version;
+    }
+
+    bool GlyphAtlas::Allocate(int width, int height, int& x, int& y) {
+        if (width > m_Width)
+            return false;
+
+        if (m_ShelfX + width > m_Width) {
+            m_ShelfY += m_ShelfHeight;
+            m_ShelfX      = 0;
+            m_ShelfHeight = 0;
+        }
+        while (m_ShelfY + height > m_Height) {
+            if (m_Height >= kMaxAtlasHeight)
+                return false;
+            m_Height = std::min(m_Height * 2, kMaxAtlasHeight);
+            m_Pixels.resize(static_cast<size_t>(m_Width) * m_Height, 0);
+        }
+
+        x = m_ShelfX;
+        y = m_ShelfY;
+        m_ShelfX += width;
+        m_ShelfHeight = std::max(m_ShelfHeight, height);
+        return true;
+    }
+
+    float GlyphAtlas::Kerning(uint32_t left, uint32_t right) {
+        const uint8_t source = Find(left).source;
+        return Find(right).source == source ? m_Sources[source]->Kerning(left, right) : 0.0f;
+    }
+
+    const std::vector<GlyphAtlas::Placement>& GlyphAtlas::Shape(std::string_view line) {
+        auto [it, inserted] = m_Runs.try_emplace(std::hash<std::string_view>{}(line));
+        Run& run            = it->second;
+        run.lastUsed        = ++m_RunClock;
+        if (!inserted && run.text == line)
+            return run.glyphs;
+
+        run.text.assign(line);
+        run.glyphs.clear();
+        run.width = ShapeLine(line, &run.glyphs);
+
+        if (m_Runs.size() > kMaxRuns) {
+            const uint64_t keepFrom = m_RunClock - kMaxRuns / 2;
+            std::erase_if(m_Runs, [keepFrom](const auto& entry) { return entry.second.lastUsed < keepFrom; });
+        }
+        return run.glyphs;
+    }
+
+    // Places the glyphs of one line when given a vector to fill and returns its pen advance
+    float GlyphAtlas::ShapeLine(std::string_view line, std::vector<Placement>* glyphs) {
+        m_ShapeScratch.clear();
+        if (m_Sources[0]->Shape(line, m_ShapeScratch)) {
+            // Glyphs the shaping font lacks come from the fallbacks by code point; later glyphs shift by the
+            // difference in advance
+            float advance = 0.0f, shift = 0.0f;
+            for (const ShapedGlyph& shaped : m_ShapeScratch) {
+                const Glyph* glyph = nullptr;
+                if (shaped.glyph == 0) {
+                    size_t i = shaped.cluster;
+                    glyph    = &Find(DecodeUtf8(line, i));
+                } else if (glyphs) {
+                    glyph = &FindShaped(shaped.glyph);
+                }
+                if (glyphs)
+                    glyphs->push_back({glyph, shaped.x + shift, shaped.y});
+                if (shaped.glyph == 0)
+                    shift += glyph->advance - shaped.advance;
+                advance += shaped.advance;
+            }
+            return advance + shift;
+        }
+
+        float    penX = 0.0f;
+        uint32_t prev = 0;
+        for (size_t i = 0; i < line.size();) {
+            const uint32_t cp    = DecodeUtf8(line, i);
+            const Glyph&   glyph = Find(cp);
+            if (prev)
+                penX += Kerning(prev, cp);
+            if (glyphs)
+                glyphs->push_back({&glyph, penX, 0.0f});
+            penX += glyph.advance;
+            prev = cp;
+        }
+        return penX;
+    }
+
+    // Layout measures many candidate lines that are never drawn, so they are shaped without entering the run cache
+    float GlyphAtlas::MeasureRun(std::string_view run) {
+        if (auto it = m_Runs.find(std::hash<std::string_view>{}(run)); it != m_Runs.end() && it->second.text == run)
+            return it->second.width;
+        return ShapeLine(run, nullptr);
+    }
+
+    size_t GlyphAtlas::BuildQuads(std::string_view text, Vector2 pos, float fontSize, Color color,
+                                  std::vector<Vertex2D>& out) {
+        const size_t first      = out.size();
+        const float  scale      = Scale(fontSize);
+        const float  lineHeight = LineHeight() * scale;
+
+        float penY = pos.y;
+        for (size_t start = 0; start <= text.size();) {
+            size_t end = text.find('\n', start);
+            if (end == std::string_view::npos)
+                end = text.size();
+
+            for (const Placement& p : Shape(text.substr(start, end - start))) {
+                const Glyph& g = *p.glyph;
+                if (g.region.width <= 0.0f)
+                    continue;
+
+                const float x0 = pos.x + (p.x + g.offsetX) * scale, x1 = x0 + g.region.width * scale;
+                const float y0 = penY + (p.y + g.offsetY) * scale, y1 = y0 + g.region.height * scale;
+                const float u0 = g.region.x, u1 = u0 + g.region.width;
+                const float v0 = g.region.y, v1 = v0 + g.region.height;
+                out.push_back({{x0, y0}, color, {u0, v0}});
+                out.push_back({{x1, y0}, color, {u1, v0}});
+                out.push_back({{x0, y1}, color, {u0, v1}});
+                out.push_back({{x1, y1}, color, {u1, v1}});
+            }
+
+            start = end + 1;
+            penY += lineHeight;
+        }
+
+        // Normalize last: loading a glyph above may have grown the atlas
+        const float invW = 1.0f / static_cast<float>(m_Width), invH = 1.0f / static_cast<float>(m_Height);
+        for (size_t v = first; v < out.size(); ++v) {
+            out[v].texCoord.x *= invW;
+            out[v].texCoord.y *= invH;
+        }
+        return (out.size() - first) / 4;
+    }
+
+}  // namespace ugfx
@@ -10,7 +10,9 @@
 
 namespace ugfx {
 
-    GraphicsBackend::GraphicsBackend() = default;
+    GraphicsBackend::GraphicsBackend() {
+        m_FrameStats.startup.origin = std::chrono::steady_clock::now();
+    }
 
     GraphicsBackend::~GraphicsBackend() {
         if (m_Window)
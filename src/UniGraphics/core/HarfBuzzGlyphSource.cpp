@@ -0,0 +1,303 @@
+#include "HarfBuzzGlyphSource.h"
+
+#ifdef UGFX_USE_HARFBUZZ
+
+#include <harfbuzz/hb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace ugfx {
+
+    namespace {
+
+        // Signed area accumulation: every outline edge adds its coverage delta to the cells it crosses and a
+        // running sum along each row yields the winding coverage. Edges are in bitmap pixels, y down.
+        class OutlineRasterizer {
+           public:
+            void Reset(int width, int height) {
+                m_Width  = width;
+                m_Height = height;
+                m_Accum.assign(static_cast<size_t>(width + 2) * height, 0.0f);
+            }
+
+            void MoveTo(float x, float y) {
+                Close();
+                m_StartX = m_X = x;
+                m_StartY = m_Y = y;
+            }
+
+            void LineTo(float x, float y) {
+                Edge(m_X, m_Y, x, y);
+                m_X = x;
+                m_Y = y;
+            }
+
+            void QuadTo(float cx, float cy, float x, float y) {
+                const float x0 = m_X, y0 = m_Y;
+                const int   steps = Steps(std::abs(x0 - 2.0f * cx + x) + std::abs(y0 - 2.0f * cy + y));
+                for (int i = 1; i <= steps; ++i) {
+                    const float t = static_cast<float>(i) / steps, u = 1.0f - t;
+                    LineTo(u * u * x0 + 2.0f * u * t * cx + t * t * x, u * u * y0 + 2.0f * u * t * cy + t * t * y);
+                }
+            }
+
+            void CubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) {
+                const float x0 = m_X, y0 = m_Y;
+                const float dd = std::max(std::abs(x0 - 2.0f * c1x + c2x) + std::abs(y0 - 2.0f * c1y + c2y),
+                                          std::abs(c1x - 2.0f * c2x + x) + std::abs(c1y - 2.0f * c2y + y));
+                const int   steps = Steps(dd * 1.5f);
+                for (int i = 1; i <= steps; ++i) {
+                    const float t = static_cast<float>(i) / steps, u = 1.0f - t;
+                    const float a = u * u * u, b = 3.0f * u * u * t, c = 3.0f * u * t * t, d = t * t * t;
+                    LineTo(a * x0 + b * c1x + c * c2x + d * x, a * y0 + b * c1y + c * c2y + d * y);
+                }
+            }
+
+            void Close() { LineTo(m_StartX, m_StartY); }
+
+            void Resolve(std::vector<uint8_t>& out) const {
+                out.resize(static_cast<size_t>(m_Width) * m_Height);
+                for (int y = 0; y < m_Height; ++y) {
+                    float acc = 0.0f;
+                    for (int x = 0; x < m_Width; ++x) {
+                        acc += m_Accum[y * (m_Width + 2) + x];
+                        out[y * m_Width + x] = static_cast<uint8_t>(std::min(std::abs(acc), 1.0f) * 255.0f + 0.5f);
+                    }
+                }
+            }
+
+           private:
+            // Enough segments to keep a curve within about a tenth of a pixel of its chord
+            static int Steps(float deviation) {
+                return std::clamp(static_cast<int>(std::ceil(std::sqrt(deviation * 2.5f))), 1, 32);
+            }
+
+            void Edge(float x0, float y0, float x1, float y1) {
+                if (y0 == y1)
+                    return;
+                float dir = 1.0f;
+                if (y0 > y1) {
+                    dir = -1.0f;
+                    std::swap(x0, x1);
+                    std::swap(y0, y1);
+                }
+                x0 = std::clamp(x0, 0.0f, static_cast<float>(m_Width));
+                x1 = std::clamp(x1, 0.0f, static_cast<float>(m_Width));
+
+                const float dxdy = (x1 - x0) / (y1 - y0);
+                float       x    = y0 < 0.0f ? x0 - y0 * dxdy : x0;
+                const int   yEnd = std::min(m_Height, static_cast<int>(std::ceil(y1)));
+                for (int y = std::max(0, static_cast<int>(y0)); y < yEnd; ++y) {
+                    float*      row   = &m_Accum[static_cast<size_t>(y) * (m_Width + 2)];
+                    const float dy    = std::min(static_cast<float>(y + 1), y1) - std::max(static_cast<float>(y), y0);
+                    const float xNext = x + dxdy * dy;
+                    const float d     = dy * dir;
+                    const float left  = std::min(x, xNext), right = std::max(x, xNext);
+                    const float leftFloor = std::floor(left);
+                    const int   li = static_cast<int>(leftFloor), ri = static_cast<int>(std::ceil(right));
+                    if (ri <= li + 1) {
+                        const float mid = 0.5f * (x + xNext) - leftFloor;
+                        row[li] += d - d * mid;
+                        row[li + 1] += d * mid;
+                    } else {
+                        const float s       = 1.0f / (right - left);
+                        const float leftFr  = left - leftFloor;
+                        const float a0      = 0.5f * s * (1.0f - leftFr) * (1.0f - leftFr);
+                        const float rightFr = right - static_cast<float>(ri) + 1.0f;
+                        const float am      = 0.5f * s * rightFr * rightFr;
+                        row[li] += d * a0;
+                        if (ri == li + 2) {
+                            row[li + 1] += d * (1.0f - a0 - am);
+                        } else {
+                            const float a1 = s * (1.5f - leftFr);
+                            row[li + 1] += d * (a1 - a0);
+                            for (int xi = li + 2; xi < ri - 1; ++xi)
+                                row[xi] += d * s;
+                            const float a2 = a1 + static_cast<float>(ri - li - 3) * s;
+                            row[ri - 1] += d * (1.0f - a2 - am);
+                        }
+                        row[ri] += d * am;
+                    }
+                    x = xNext;
+                }
+            }
+
+            int                m_Width = 0, m_Height = 0;
+            float              m_X = 0.0f, m_Y = 0.0f, m_StartX = 0.0f, m_StartY = 0.0f;
+            std::vector<float> m_Accum;
+        };
+
+        // Draw callbacks receive 26.6 font coordinates, y up; this maps them into the bitmap
+        struct OutlineTarget {
+            OutlineRasterizer* raster;
+            float              left, top;
+
+            float X(float x) const { return x / 64.0f - left; }
+            float Y(float y) const { return top - y / 64.0f; }
+        };
+
+        void MoveTo(hb_draw_funcs_t*, void* data, hb_draw_state_t*, float x, float y, void*) {
+            auto* t = static_cast<OutlineTarget*>(data);
+            t->raster->MoveTo(t->X(x), t->Y(y));
+        }
+
+        void LineTo(hb_draw_funcs_t*, void* data, hb_draw_state_t*, float x, float y, void*) {
+            auto* t = static_cast<OutlineTarget*>(data);
+            t->raster->LineTo(t->X(x), t->Y(y));
+        }
+
+        void QuadTo(hb_draw_funcs_t*, void* data, hb_draw_state_t*, float cx, float cy, float x, float y, void*) {
+            auto* t = static_cast<OutlineTarget*>(data);
+            t->raster->QuadTo(t->X(cx), t->Y(cy), t->X(x), t->Y(y));
+        }
+
+        void CubicTo(hb_draw_funcs_t*, void* data, hb_draw_state_t*, float c1x, float c1y, float c2x, float c2y,
+                     float x, float y, void*) {
+            auto* t = static_cast<OutlineTarget*>(data);
+            t->raster->CubicTo(t->X(c1x), t->Y(c1y), t->X(c2x), t->Y(c2y), t->X(x), t->Y(y));
+        }
+
+        void ClosePath(hb_draw_funcs_t*, void* data, hb_draw_state_t*, void*) {
+            static_cast<OutlineTarget*>(data)->raster->Close();
+        }
+
+        class HarfBuzzGlyphSource : public IGlyphSource {
+           public:
+            HarfBuzzGlyphSource(std::vector<uint8_t> data, int baseSize)
+                : m_Data(std::move(data)), m_BaseSize(baseSize) {
+                hb_blob_t* blob = hb_blob_create(reinterpret_cast<const char*>(m_Data.data()),
+                                                 static_cast<unsigned>(m_Data.size()), HB_MEMORY_MODE_READONLY,
+                                                 nullptr, nullptr);
+                hb_face_t* face = hb_face_create(blob, 0);
+                m_Font          = hb_font_create(face);
+                hb_face_destroy(face);
+                hb_blob_destroy(blob);
+                hb_font_set_scale(m_Font, baseSize * 64, baseSize * 64);
+
+                hb_font_extents_t extents = {};
+                hb_font_get_h_extents(m_Font, &extents);
+                m_Ascender   = static_cast<float>(extents.ascender) / 64.0f;
+                m_LineHeight = static_cast<float>(extents.ascender - extents.descender + extents.line_gap) / 64.0f;
+
+                m_Buffer = hb_buffer_create();
+                m_Draw   = hb_draw_funcs_create();
+                hb_draw_funcs_set_move_to_func(m_Draw, MoveTo, nullptr, nullptr);
+                hb_draw_funcs_set_line_to_func(m_Draw, LineTo, nullptr, nullptr);
+                hb_draw_funcs_set_quadratic_to_func(m_Draw, QuadTo, nullptr, nullptr);
+                hb_draw_funcs_set_cubic_to_func(m_Draw, CubicTo, nullptr, nullptr);
+                hb_draw_funcs_set_close_path_func(m_Draw, ClosePath, nullptr, nullptr);
+                hb_draw_funcs_make_immutable(m_Draw);
+            }
+
+            ~HarfBuzzGlyphSource() override {
+                hb_draw_funcs_destroy(m_Draw);
+                hb_buffer_destroy(m_Buffer);
+                hb_font_destroy(m_Font);
+            }
+
+            HarfBuzzGlyphSource(const HarfBuzzGlyphSource&)            = delete;
+            HarfBuzzGlyphSource& operator=(const HarfBuzzGlyphSource&) = delete;
+
+            bool Valid() const { return hb_face_get_glyph_count(hb_font_get_face(m_Font)) > 0; }
+
+            int   BaseSize() const override { return m_BaseSize; }
+            float LineHeight() const override { return m_LineHeight; }
+
+            bool Rasterize(uint32_t codepoint, GlyphBitmap& out) override {
+                hb_codepoint_t glyph = 0;
+                return hb_font_get_nominal_glyph(m_Font, codepoint, &glyph) && RasterizeGlyph(glyph, out);
+            }
+
+            bool CanShape() const override { return true; }
+            bool Shape(std::string_view text, std::vector<ShapedGlyph>& out) override {
+                hb_buffer_clear_contents(m_Buffer);
+                hb_buffer_add_utf8(m_Buffer, text.data(), static_cast<int>(text.size()), 0,
+                                   static_cast<int>(text.size()));
+                hb_buffer_guess_segment_properties(m_Buffer);
+                hb_shape(m_Font, m_Buffer, nullptr, 0);
+
+                unsigned int               count     = 0;
+                const hb_glyph_info_t*     infos     = hb_buffer_get_glyph_infos(m_Buffer, &count);
+                const hb_glyph_position_t* positions = hb_buffer_get_glyph_positions(m_Buffer, &count);
+
+                float penX = 0.0f, penY = 0.0f;
+                for (unsigned int i = 0; i < count; ++i) {
+                    const hb_glyph_position_t& p       = positions[i];
+                    const float                advance = static_cast<float>(p.x_advance) / 64.0f;
+                    out.push_back({infos[i].codepoint, infos[i].cluster, penX + static_cast<float>(p.x_offset) / 64.0f,
+                                   penY - static_cast<float>(p.y_offset) / 64.0f, advance});
+                    penX += advance;
+                    penY -= static_cast<float>(p.y_advance) / 64.0f;
+                }
+                return true;
+            }
+
+            bool RasterizeGlyph(uint32_t glyph, GlyphBitmap& out) override {
+                out.advance = static_cast<float>(hb_font_get_glyph_h_advance(m_Font, glyph)) / 64.0f;
+
+                hb_glyph_extents_t extents = {};
+                if (!hb_font_get_glyph_extents(m_Font, glyph, &extents) || extents.width == 0 || extents.height == 0)
+                    return true;  // blank glyph, advance only
+
+                const int left   = static_cast<int>(std::floor(extents.x_bearing / 64.0f));
+                const int right  = static_cast<int>(std::ceil((extents.x_bearing + extents.width) / 64.0f));
+                const int top    = static_cast<int>(std::ceil(extents.y_bearing / 64.0f));
+                const int bottom = static_cast<int>(std::floor((extents.y_bearing + extents.height) / 64.0f));
+                out.width        = right - left;
+                out.height       = top - bottom;
+                out.offsetX      = left;
+                out.offsetY      = static_cast<int>(std::lround(m_Ascender)) - top;
+
+                m_Raster.Reset(out.width, out.height);
+                OutlineTarget target = {&m_Raster, static_cast<float>(left), static_cast<float>(top)};
+                hb_font_draw_glyph(m_Font, glyph, m_Draw, &target);
+                m_Raster.Close();
+                m_Raster.Resolve(out.coverage);
+                return true;
+            }
+
+           private:
+            std::vector<uint8_t> m_Data;  // the blob points into this
+            int                  m_BaseSize   = 0;
+            float                m_Ascender   = 0.0f;
+            float                m_LineHeight = 0.0f;
+            hb_font_t*           m_Font       = nullptr;
+            hb_buffer_t*         m_Buffer     = nullptr;
+            hb_draw_funcs_t*     m_Draw       = nullptr;
+            OutlineRasterizer    m_Raster;
+        };
+
+    }  // namespace
+
+    bool HarfBuzzAvailable() {
+        return true;
+    }
+
+    std::unique_ptr<IGlyphSource> CreateHarfBuzzGlyphSource(std::vector<uint8_t> fontData, int baseSize) {
+        auto source = std::make_unique<HarfBuzzGlyphSource>(std::move(fontData), baseSize);
+        if (!source->Valid()) {
+            std::cerr << "HarfBuzz: font data has no glyphs\n";
+            return nullptr;
+        }
+        return source;
+    }
+
+}  // namespace ugfx
+
+#else
+
+namespace ugfx {
+
+    bool HarfBuzzAvailable() {
+        return false;
+    }
+
+    std::unique_ptr<IGlyphSource> CreateHarfBuzzGlyphSource(std::vector<uint8_t>, int) {
+        return nullptr;
+    }
+
+}  // namespace ugfx
+
+#endif
@@ -0,0 +1,275 @@
+#include "InputRecording.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace ugfx {
+
+    namespace {
+
+        constexpr char    kMagic[4] = {'U', 'G', 'I', 'R'};
+        constexpr uint8_t kVersion  = 1;
+
+        void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+            for (; value >= 0x80; value >>= 7)
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        void PutFloat(std::vector<uint8_t>& out, float value) {
+            uint8_t bytes[sizeof(float)];
+            std::memcpy(bytes, &value, sizeof(bytes));
+            out.insert(out.end(), bytes, bytes + sizeof(bytes));
+        }
+
+        // Bounds-checked reader over the loaded log; any read past the end marks it failed
+        struct Reader {
+            const uint8_t* data;
+            size_t         size;
+            size_t         pos    = 0;
+            bool           failed = false;
+
+            bool AtEnd() const { return pos >= size; }
+
+            uint8_t Byte() {
+                if (pos >= size) {
+                    failed = true;
+                    return 0;
+                }
+                return data[pos++];
+            }
+
+            uint64_t Varint() {
+                uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    const uint8_t b = Byte();
+                    value |= static_cast<uint64_t>(b & 0x7F) << shift;
+                    if (!(b & 0x80))
+                        return value;
+                }
+                failed = true;
+                return 0;
+            }
+
+            float Float() {
+                float value = 0.0f;
+                if (pos + sizeof(float) > size) {
+                    failed = true;
+                    return value;
+                }
+                std::memcpy(&value, data + pos, sizeof(float));
+                pos += sizeof(float);
+                return value;
+            }
+        };
+
+        // type in the low 3 bits, key repeat in bit 3, mouse button or window action in the high 4 bits
+        uint8_t PackType(const InputEvent& e) {
+            const uint8_t extra = e.type == InputEvent::Type::Window ? static_cast<uint8_t>(e.window)
+                                                                     : static_cast<uint8_t>(e.button);
+            return static_cast<uint8_t>(static_cast<uint8_t>(e.type) | (e.repeat ? 0x08 : 0) | (extra << 4));
+        }
+
+    }  // namespace
+
+    bool InputRecorder::Open(const std::string& path) {
+        Close();
+        m_File.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_File) {
+            std::cerr << "InputRecorder: cannot create " << path << std::endl;
+            return false;
+        }
+        m_File.write(kMagic, sizeof(kMagic));
+        m_File.put(static_cast<char>(kVersion));
+        m_Frames = 0;
+        return true;
+    }
+
+    void InputRecorder::Close() {
+        if (m_File.is_open())
+            m_File.close();
+    }
+
+    void InputRecorder::RecordFrame(float deltaTime, std::span<const InputEvent> events) {
+        if (!m_File.is_open())
+            return;
+
+        m_Buffer.clear();
+        PutVarint(m_Buffer, static_cast<uint64_t>(std::max(deltaTime, 0.0f) * 1e6f));
+        PutVarint(m_Buffer, events.size());
+
+        const uint64_t first = events.empty() ? 0 : events.front().timestamp;
+        for (const InputEvent& e : events) {
+            m_Buffer.push_back(PackType(e));
+            PutVarint(m_Buffer, e.timestamp > first ? (e.timestamp - first) / 1000 : 0);
+
+            switch (e.type) {
+                case InputEvent::Type::KeyDown:
+                case InputEvent::Type::KeyUp:
+                    PutVarint(m_Buffer, static_cast<uint64_t>(e.key));
+                    break;
+                case InputEvent::Type::Text:
+                    PutVarint(m_Buffer, e.codepoint);
+                    break;
+                case InputEvent::Type::MouseMove:
+                    PutFloat(m_Buffer, e.position.x);
+                    PutFloat(m_Buffer, e.position.y);
+                    PutFloat(m_Buffer, e.delta.x);
+                    PutFloat(m_Buffer, e.delta.y);
+                    break;
+                case InputEvent::Type::MouseDown:
+                case InputEvent::Type::MouseUp:
+                    PutFloat(m_Buffer, e.position.x);
+                    PutFloat(m_Buffer, e.position.y);
+                    break;
+                case InputEvent::Type::Wheel:
+                    PutFloat(m_Buffer, e.delta.x);
+                    PutFloat(m_Buffer, e.delta.y);
+                    break;
+                case InputEvent::Type::Window:
+                    if (e.window == WindowAction::Resized) {
+                        PutFloat(m_Buffer, e.position.x);
+                        PutFloat(m_Buffer, e.position.y);
+                    }
+                    break;
+            }
+        }
+        m_File.write(reinterpret_cast<const char*>(m_Buffer.data()), static_cast<std::streamsize>(m_Buffer.size()));
+        ++m_Frames;
+    }
+
+    bool ReplayInput::Load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "ReplayInput: cannot open " << path << std::endl;
+            return false;
+        }
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (bytes.size() < sizeof(kMagic) + 1 || std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0 ||
+            bytes[sizeof(kMagic)] != kVersion) {
+            std::cerr << "ReplayInput: " << path << " is not a version " << int(kVersion) << " input log" << std::endl;
+            return false;
+        }
+
+        m_Events.clear();
+        m_FrameStarts.clear();
+        m_Deltas.clear();
+
+        Reader in{bytes.data(), bytes.size(), sizeof(kMagic) + 1};
+        while (!in.AtEnd() && !in.failed) {
+            m_Deltas.push_back(static_cast<float>(in.Varint()) / 1e6f);
+            m_FrameStarts.push_back(static_cast<uint32_t>(m_Events.size()));
+
+            const uint64_t count = in.Varint();
+            for (uint64_t i = 0; i < count && !in.failed; ++i) {
+                const uint8_t packed = in.Byte();
+                InputEvent    e;
+                e.type      = static_cast<InputEvent::Type>(packed & 0x07);
+                e.repeat    = (packed & 0x08) != 0;
+                e.timestamp = in.Varint() * 1000;  // offset for now, rebased in EndFrame
+                if (e.type == InputEvent::Type::Window)
+                    e.window = static_cast<WindowAction>(packed >> 4);
+                else
+                    e.button = static_cast<MouseButton>(packed >> 4);
+
+                switch (e.type) {
+                    case InputEvent::Type::KeyDown:
+                    case InputEvent::Type::KeyUp:
+                        e.key = static_cast<Key>(in.Varint());
+                        break;
+                    case InputEvent::Type::Text:
+                        e.codepoint = static_cast<uint32_t>(in.Varint());
+                        break;
+                    case InputEvent::Type::MouseMove:
+                        e.position = {in.Float(), in.Float()};
+                        e.delta    = {in.Float(), in.Float()};
+                        break;
+                    case InputEvent::Type::MouseDown:
+                    case InputEvent::Type::MouseUp:
+                        e.position = {in.Float(), in.Float()};
+                        break;
+                    case InputEvent::Type::Wheel:
+                        e.delta = {in.Float(), in.Float()};
+                        break;
+                    case InputEvent::Type::Window:
+                        if (e.window == WindowAction::Resized)
+                            e.position = {in.Float(), in.Float()};
+                        break;
+                    default:
+                        in.failed = true;
+                        break;
+                }
+                m_Events.push_back(e);
+            }
+        }
+        if (in.failed) {
+            std::cerr << "ReplayInput: " << path << " is truncated or corrupt" << std::endl;
+            m_Events.clear();
+            m_FrameStarts.clear();
+            m_Deltas.clear();
+            return false;
+        }
+
+        m_Frame   = 0;
+        m_Keys    = {};
+        m_Pointer = {};
+        m_Current.clear();
+        return true;
+    }
+
+    float ReplayInput::DeltaTime() const {
+        if (m_FixedDelta > 0.0f || m_Frame == 0)
+            return m_FixedDelta;
+        return m_Deltas[std::min(m_Frame, m_Deltas.size()) - 1];
+    }
+
+    void ReplayInput::BeginFrame() {
+        m_Keys.BeginFrame();
+        m_Current.clear();
+        m_Pointer.BeginFrame();
+    }
+
+    void ReplayInput::EndFrame() {
+        if (Finished())
+            return;
+
+        const size_t begin = m_FrameStarts[m_Frame];
+        const size_t end   = m_Frame + 1 < m_FrameStarts.size() ? m_FrameStarts[m_Frame + 1] : m_Events.size();
+        ++m_Frame;
+
+        // Logged timestamps are offsets from the frame's first event; put the frame on the replay clock
+        const uint64_t now = SteadyNanoseconds();
+        for (size_t i = begin; i < end; ++i) {
+            InputEvent& e = m_Current.emplace_back(m_Events[i]);
+            e.timestamp += now;
+            m_Pointer.Apply(e);
+            if (e.type == InputEvent::Type::KeyDown && !e.repeat)
+                m_Keys.Press(e.key);
+            else if (e.type == InputEvent::Type::KeyUp)
+                m_Keys.Release(e.key);
+        }
+        m_Bus.Dispatch(m_Current);
+    }
+
+    void ReplayInput::Snapshot(InputSnapshot& out) const {
+        out.timestamp = SteadyNanoseconds();
+        out.keys      = m_Keys;
+        out.pointer   = m_Pointer;
+        out.gamepads  = {};
+    }
+
+    bool ReplayInput::IsMouseButtonDown(MouseButton button) const {
+        return PointerState::Test(m_Pointer.down, button);
+    }
+
+    bool ReplayInput::IsMouseButtonPressed(MouseButton button) const {
+        return PointerState::Test(m_Pointer.pressed, button);
+    }
+
+    bool ReplayInput::IsMouseButtonReleased(MouseButton button) const {
+        return PointerState::Test(m_Pointer.released, button);
+    }
+
+}  // namespace ugfx
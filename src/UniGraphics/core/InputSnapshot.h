@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../CommonTypes.h"
+#include "InputEvents.h"
+
+namespace ugfx {
+
+    using ActionId = uint8_t;  // application-defined, below ActionState::kMaxActions
+
+    struct GamepadSnapshot {
+        using Buttons = std::bitset<static_cast<size_t>(GamepadButton::Count)>;
+        using Axes    = std::array<float, static_cast<size_t>(GamepadAxis::Count)>;
+
+        bool    connected = false;
+        Axes    axes      = {};
+        Buttons down, pressed, released;
+    };
+
+    // Actions resolved by an ActionMap for one frame
+    struct ActionState {
+        static constexpr size_t kMaxActions = 64;
+
+        std::bitset<kMaxActions>       down, pressed, released;
+        std::array<float, kMaxActions> value = {};  // strongest binding: 1 for buttons, the scaled axis for axes
+    };
+
+    // The input of one frame as plain data: filled by IInput::Snapshot after PollEvents, then optionally by
+    // ActionMap::Resolve. Queries are bit tests with no backend involved, and the snapshot is trivially copyable,
+    // so simulation jobs on other threads can take their own copy.
+    struct InputSnapshot {
+        static constexpr int kGamepads = 4;
+
+        uint64_t                               timestamp = 0;  // when it was taken, SteadyNanoseconds()
+        KeyboardState                          keys;
+        PointerState                           pointer;
+        std::array<GamepadSnapshot, kGamepads> gamepads;
+        ActionState                            actions;
+
+        bool IsKeyDown(Key key) const { return KeyboardState::Test(keys.down, key); }
+        bool IsKeyPressed(Key key) const { return KeyboardState::Test(keys.pressed, key); }
+        bool IsKeyReleased(Key key) const { return KeyboardState::Test(keys.released, key); }
+
+        bool IsMouseButtonDown(MouseButton button) const { return PointerState::Test(pointer.down, button); }
+        bool IsMouseButtonPressed(MouseButton button) const { return PointerState::Test(pointer.pressed, button); }
+
+        bool IsGamepadButtonDown(int gamepad, GamepadButton button) const {
+            return gamepad >= 0 && gamepad < kGamepads && Test(gamepads[gamepad].down, static_cast<size_t>(button));
+        }
+        bool IsGamepadButtonPressed(int gamepad, GamepadButton button) const {
+            return gamepad >= 0 && gamepad < kGamepads && Test(gamepads[gamepad].pressed, static_cast<size_t>(button));
+        }
+        float GetGamepadAxis(int gamepad, GamepadAxis axis) const {
+            const auto a = static_cast<size_t>(axis);
+            return gamepad >= 0 && gamepad < kGamepads && a < kAxes ? gamepads[gamepad].axes[a] : 0.0f;
+        }
+
+        bool  IsActionDown(ActionId action) const { return Test(actions.down, action); }
+        bool  IsActionPressed(ActionId action) const { return Test(actions.pressed, action); }
+        bool  IsActionReleased(ActionId action) const { return Test(actions.released, action); }
+        float GetActionValue(ActionId action) const { return action < kActions ? actions.value[action] : 0.0f; }
+
+       private:
+        static constexpr size_t kAxes    = static_cast<size_t>(GamepadAxis::Count);
+        static constexpr size_t kActions = ActionState::kMaxActions;
+
+        template <size_t N>
+        static bool Test(const std::bitset<N>& bits, size_t i) {
+            return i < N && bits[i];
+        }
+    };
+
+    static_assert(std::is_trivially_copyable_v<InputSnapshot>);
+
+}  // namespace ugfx
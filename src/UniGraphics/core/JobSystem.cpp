@@ -0,0 +1,90 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace ugfx {
+
+    JobSystem::JobSystem(unsigned workerCount) {
+        m_Workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i)
+            m_Workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Wake.notify_all();
+        for (std::thread& worker : m_Workers)
+            worker.join();
+    }
+
+    unsigned JobSystem::DefaultWorkerCount() {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+    JobSystem& JobSystem::Shared() {
+        static JobSystem shared;
+        return shared;
+    }
+
+    void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+        if (count == 0)
+            return;
+        grain = std::max<size_t>(1, grain);
+        if (m_Workers.empty() || count <= grain) {
+            fn(0, count);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit(m_SubmitMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Fn       = &fn;
+            m_Count    = count;
+            m_Grain    = grain;
+            m_Finished = 0;
+            m_Next.store(0, std::memory_order_relaxed);
+            ++m_Generation;
+        }
+        m_Wake.notify_all();
+
+        RunChunks();
+
+        // Every worker checks in, even with no chunk left, so none can still see this loop afterwards
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Done.wait(lock, [this] { return m_Finished == m_Workers.size(); });
+        m_Fn = nullptr;
+    }
+
+    void JobSystem::RunChunks() {
+        for (;;) {
+            size_t begin = m_Next.fetch_add(m_Grain, std::memory_order_relaxed);
+            if (begin >= m_Count)
+                return;
+            (*m_Fn)(begin, std::min(begin + m_Grain, m_Count));
+        }
+    }
+
+    void JobSystem::WorkerLoop() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Wake.wait(lock, [&] { return m_Stop || m_Generation != seen; });
+                if (m_Stop)
+                    return;
+                seen = m_Generation;
+            }
+
+            RunChunks();
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (++m_Finished == m_Workers.size())
+                m_Done.notify_one();
+        }
+    }
+
+}  // namespace ugfx
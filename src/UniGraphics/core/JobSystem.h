@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ugfx {
+
+    // Small fixed worker pool for data-parallel loops. The calling thread takes part in every ParallelFor, so a
+    // pool with zero workers simply runs the loop inline.
+    class JobSystem {
+       public:
+        explicit JobSystem(unsigned workerCount = DefaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem&)            = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        unsigned WorkerCount() const { return static_cast<unsigned>(m_Workers.size()); }
+
+        // Calls fn(begin, end) over [0, count) in chunks of grain items and returns once all chunks are done.
+        // One loop runs at a time; concurrent callers are serialized.
+        void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+        static unsigned   DefaultWorkerCount();  // hardware threads minus the caller
+        static JobSystem& Shared();
+
+       private:
+        void WorkerLoop();
+        void RunChunks();
+
+        std::vector<std::thread> m_Workers;
+
+        std::mutex              m_SubmitMutex;
+        std::mutex              m_Mutex;
+        std::condition_variable m_Wake;
+        std::condition_variable m_Done;
+        uint64_t                m_Generation = 0;
+        unsigned                m_Finished   = 0;  // workers done with the current generation
+        bool                    m_Stop       = false;
+
+        // Current loop, stable until every worker reported back
+        const std::function<void(size_t, size_t)>* m_Fn    = nullptr;
+        size_t                                     m_Count = 0;
+        size_t                                     m_Grain = 1;
+        std::atomic<size_t>                        m_Next  = 0;
+    };
+
+}  // namespace ugfx
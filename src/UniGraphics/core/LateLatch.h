@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace ugfx {
+
+    // How long a late-latched frame may wait before pumping events. A present that blocks on vsync leaves slack
+    // at the end of the frame; moving the smallest slack of the recent frames (less a margin for jitter) to the
+    // start samples input that much closer to the present without missing the refresh. A frame that runs long
+    // shrinks the slack and the delay follows on the next frame.
+    class LateLatch {
+       public:
+        static constexpr float  kMarginMs = 2.0f;
+        static constexpr size_t kWindow   = 32;  // frames of history before any delay is applied
+
+        void Reset() {
+            m_Count   = 0;
+            m_Next    = 0;
+            m_DelayMs = 0.0f;
+        }
+
+        // After each presented frame: its present wait, plus the delay it was started with
+        void Record(float presentWaitMs) {
+            m_Slack[m_Next] = presentWaitMs + m_DelayMs;
+            m_Next          = (m_Next + 1) % kWindow;
+            m_Count         = std::min(m_Count + 1, kWindow);
+        }
+
+        // Delay for the frame about to start
+        float NextDelayMs() {
+            if (m_Count < kWindow)
+                return m_DelayMs = 0.0f;
+            const float slack = *std::min_element(m_Slack.begin(), m_Slack.end());
+            return m_DelayMs = std::max(slack - kMarginMs, 0.0f);
+        }
+
+       private:
+        std::array<float, kWindow> m_Slack{};
+        size_t                     m_Count   = 0;
+        size_t                     m_Next    = 0;
+        float                      m_DelayMs = 0.0f;
+    };
+
+}  // namespace ugfx
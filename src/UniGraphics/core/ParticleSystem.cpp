@@ -0,0 +1,161 @@
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "JobSystem.h"
+#include "SimdMath.h"
+#include "SpriteBatch.h"
+
+namespace ugfx {
+
+    static constexpr size_t kParticleGrain = 16384;  // particles per job chunk, a multiple of 4
+    static constexpr float  kDegToRad      = 3.14159265358979323846f / 180.0f;
+
+    ParticleSystem::ParticleSystem(size_t capacity) : m_Capacity(capacity) {
+        const size_t padded = (capacity + 3) & ~size_t(3);
+        for (std::vector<float>* v : {&m_X, &m_Y, &m_VelX, &m_VelY, &m_Age, &m_InvLife, &m_SizeStart, &m_SizeEnd})
+            v->resize(padded, 0.0f);
+        m_ColorStart.resize(padded);
+        m_ColorEnd.resize(padded);
+    }
+
+    size_t ParticleSystem::Emit(const ParticleEmitter& e, size_t count) {
+        count = std::min(count, m_Capacity - m_Count);
+
+        // xorshift32, uniform in [0, 1)
+        auto random = [this] {
+            m_Seed ^= m_Seed << 13;
+            m_Seed ^= m_Seed >> 17;
+            m_Seed ^= m_Seed << 5;
+            return (m_Seed >> 8) * (1.0f / 16777216.0f);
+        };
+
+        for (size_t n = 0; n < count; ++n) {
+            const size_t i     = m_Count++;
+            const float  angle = (e.direction + (random() - 0.5f) * e.spread) * kDegToRad;
+            const float  speed = e.speedMin + (e.speedMax - e.speedMin) * random();
+            const float  life  = e.lifeMin + (e.lifeMax - e.lifeMin) * random();
+
+            m_X[i]          = e.position.x + (random() * 2.0f - 1.0f) * e.extent.x;
+            m_Y[i]          = e.position.y + (random() * 2.0f - 1.0f) * e.extent.y;
+            m_VelX[i]       = std::cos(angle) * speed;
+            m_VelY[i]       = std::sin(angle) * speed;
+            m_Age[i]        = 0.0f;
+            m_InvLife[i]    = life > 0.0f ? 1.0f / life : 1e9f;
+            m_SizeStart[i]  = e.sizeStart;
+            m_SizeEnd[i]    = e.sizeEnd;
+            m_ColorStart[i] = e.colorStart;
+            m_ColorEnd[i]   = e.colorEnd;
+        }
+        return count;
+    }
+
+    void ParticleSystem::Kill(size_t index) {
+        const size_t last = --m_Count;
+        if (index == last)
+            return;
+        m_X[index]          = m_X[last];
+        m_Y[index]          = m_Y[last];
+        m_VelX[index]       = m_VelX[last];
+        m_VelY[index]       = m_VelY[last];
+        m_Age[index]        = m_Age[last];
+        m_InvLife[index]    = m_InvLife[last];
+        m_SizeStart[index]  = m_SizeStart[last];
+        m_SizeEnd[index]    = m_SizeEnd[last];
+        m_ColorStart[index] = m_ColorStart[last];
+        m_ColorEnd[index]   = m_ColorEnd[last];
+    }
+
+    void ParticleSystem::Update(float dt, JobSystem* jobs) {
+        using namespace simd;
+
+        const Float4 vdt   = Set1(dt);
+        const Float4 gx    = Set1(m_Gravity.x * dt);
+        const Float4 gy    = Set1(m_Gravity.y * dt);
+        const Float4 damp  = Set1(std::max(0.0f, 1.0f - m_Drag * dt));
+        const size_t count = m_Count;
+
+        auto integrate = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i += 4) {
+                Float4 vx = Mul(Add(Load(&m_VelX[i]), gx), damp);
+                Float4 vy = Mul(Add(Load(&m_VelY[i]), gy), damp);
+                Store(&m_VelX[i], vx);
+                Store(&m_VelY[i], vy);
+                Store(&m_X[i], Add(Load(&m_X[i]), Mul(vx, vdt)));
+                Store(&m_Y[i], Add(Load(&m_Y[i]), Mul(vy, vdt)));
+                Store(&m_Age[i], Add(Load(&m_Age[i]), vdt));
+            }
+        };
+
+        const size_t blocks = (count + 3) & ~size_t(3);
+        if (jobs)
+            jobs->ParallelFor(blocks, kParticleGrain, integrate);
+        else
+            integrate(0, blocks);
+
+        // Retire expired particles; swap-remove keeps the arrays dense
+        for (size_t i = 0; i < m_Count;) {
+            if (m_Age[i] * m_InvLife[i] >= 1.0f)
+                Kill(i);
+            else
+                ++i;
+        }
+    }
+
+    void ParticleSystem::Draw(IRenderer& renderer, Texture texture, JobSystem* jobs) {
+        using namespace simd;
+
+        const size_t count = m_Count;
+        if (count == 0)
+            return;
+        m_Vertices.resize(((count + 3) & ~size_t(3)) * 4);
+
+        auto build = [&](size_t begin, size_t end) {
+            const Float4 one  = Set1(1.0f);
+            const Float4 half = Set1(0.5f);
+            for (size_t i = begin; i < end; i += 4) {
+                Float4 t    = Min(Mul(Load(&m_Age[i]), Load(&m_InvLife[i])), one);
+                Float4 s0   = Load(&m_SizeStart[i]);
+                Float4 size = Mul(Add(s0, Mul(Sub(Load(&m_SizeEnd[i]), s0), t)), half);
+                Float4 px   = Load(&m_X[i]);
+                Float4 py   = Load(&m_Y[i]);
+
+                alignas(16) float x0[4], x1[4], y0[4], y1[4], tt[4];
+                Store(x0, Sub(px, size));
+                Store(x1, Add(px, size));
+                Store(y0, Sub(py, size));
+                Store(y1, Add(py, size));
+                Store(tt, t);
+
+                const size_t lanes = std::min<size_t>(4, count - std::min(count, i));
+                for (size_t l = 0; l < lanes; ++l) {
+                    const Color& a = m_ColorStart[i + l];
+                    const Color& b = m_ColorEnd[i + l];
+                    const float  f = tt[l];
+                    const Color  c = {static_cast<unsigned char>(a.r + (b.r - a.r) * f),
+                                      static_cast<unsigned char>(a.g + (b.g - a.g) * f),
+                                      static_cast<unsigned char>(a.b + (b.b - a.b) * f),
+                                      static_cast<unsigned char>(a.a + (b.a - a.a) * f)};
+
+                    Vertex2D* v = &m_Vertices[(i + l) * 4];
+                    v[0]        = {{x0[l], y0[l]}, c, {0.0f, 0.0f}};
+                    v[1]        = {{x1[l], y0[l]}, c, {1.0f, 0.0f}};
+                    v[2]        = {{x0[l], y1[l]}, c, {0.0f, 1.0f}};
+                    v[3]        = {{x1[l], y1[l]}, c, {1.0f, 1.0f}};
+                }
+            }
+        };
+
+        const size_t blocks = (count + 3) & ~size_t(3);
+        if (jobs)
+            jobs->ParallelFor(blocks, kParticleGrain, build);
+        else
+            build(0, blocks);
+
+        BuildQuadIndices(count, m_QuadIndices);
+        renderer.DrawGeometry(texture, std::span<const Vertex2D>(m_Vertices.data(), count * 4),
+                              std::span<const int>(m_QuadIndices.data(), count * 6));
+    }
+
+}  // namespace ugfx
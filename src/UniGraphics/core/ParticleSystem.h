@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../interfaces/IRenderer.h"
+
+namespace ugfx {
+
+    class JobSystem;
+
+    struct ParticleEmitter {
+        Vector2 position   = {0.0f, 0.0f};
+        Vector2 extent     = {0.0f, 0.0f};  // half size of the spawn box around position
+        float   direction  = -90.0f;        // degrees, 0 = +x, -90 = up
+        float   spread     = 360.0f;        // degrees around direction
+        float   speedMin   = 50.0f;
+        float   speedMax   = 150.0f;
+        float   lifeMin    = 1.0f;  // seconds
+        float   lifeMax    = 2.0f;
+        float   sizeStart  = 4.0f;
+        float   sizeEnd    = 0.0f;
+        Color   colorStart = {255, 255, 255, 255};
+        Color   colorEnd   = {255, 255, 255, 0};
+    };
+
+    // Fixed-capacity particle pool in SoA layout. Update and Draw process four particles per SIMD step and can
+    // spread the work over a JobSystem; Draw submits every particle as one geometry batch of square quads.
+    class ParticleSystem {
+       public:
+        explicit ParticleSystem(size_t capacity);
+
+        // Spawns up to count particles; returns how many fit in the pool.
+        size_t Emit(const ParticleEmitter& emitter, size_t count);
+        void   Update(float dt, JobSystem* jobs = nullptr);
+        void   Draw(IRenderer& renderer, Texture texture = {}, JobSystem* jobs = nullptr);
+        void   Clear() { m_Count = 0; }
+
+        void SetGravity(Vector2 gravity) { m_Gravity = gravity; }
+        void SetDrag(float drag) { m_Drag = drag; }  // fraction of velocity lost per second
+
+        size_t Size() const { return m_Count; }
+        size_t Capacity() const { return m_Capacity; }
+
+       private:
+        void Kill(size_t index);
+
+        size_t   m_Capacity = 0;
+        size_t   m_Count    = 0;
+        Vector2  m_Gravity  = {0.0f, 0.0f};
+        float    m_Drag     = 0.0f;
+        uint32_t m_Seed     = 0x9E3779B9u;
+
+        // Padded to a multiple of four so SIMD blocks never run past the end
+        std::vector<float> m_X, m_Y, m_VelX, m_VelY, m_Age, m_InvLife, m_SizeStart, m_SizeEnd;
+        std::vector<Color> m_ColorStart, m_ColorEnd;
+
+        std::vector<Vertex2D> m_Vertices;
+        std::vector<int>      m_QuadIndices;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+namespace ugfx {
+
+    // Bookkeeping behind an event-driven window: a frame is needed after input, an explicit request, a due timer,
+    // or while any animation runs. Requests may come from any thread; times are the window's GetTicks milliseconds.
+    class RedrawTracker {
+       public:
+        void Request() { m_Requested.store(true); }
+
+        // Keeps the earliest pending timer
+        void RequestAt(uint64_t tick) {
+            uint64_t current = m_Timer.load();
+            while (tick < current && !m_Timer.compare_exchange_weak(current, tick)) {
+            }
+        }
+
+        void BeginAnimation() { m_Animations.fetch_add(1); }
+        void EndAnimation() {
+            int current = m_Animations.load();
+            while (current > 0 && !m_Animations.compare_exchange_weak(current, current - 1)) {
+            }
+        }
+        bool Animating() const { return m_Animations.load() > 0; }
+        bool HasTimer() const { return m_Timer.load() != kNoTimer; }
+
+        // How long the window may block for events: -1 until one arrives, 0 not at all
+        int WaitTimeout(uint64_t now) const {
+            if (Animating() || m_Requested.load())
+                return 0;
+            const uint64_t timer = m_Timer.load();
+            if (timer == kNoTimer)
+                return -1;
+            return timer <= now ? 0 : static_cast<int>(std::min<uint64_t>(timer - now, INT_MAX));
+        }
+
+        // Whether the frame starting now has to be rendered; consumes the request and a due timer
+        bool Update(uint64_t now, bool hadEvents) {
+            bool needed = m_Requested.exchange(false) || hadEvents || Animating();
+
+            uint64_t timer = m_Timer.load();
+            if (timer != kNoTimer && timer <= now) {
+                m_Timer.compare_exchange_strong(timer, kNoTimer);  // a newer, earlier timer wins
+                needed = true;
+            }
+            return needed;
+        }
+
+       private:
+        static constexpr uint64_t kNoTimer = UINT64_MAX;
+
+        std::atomic<bool>     m_Requested  = true;  // the first frame always renders
+        std::atomic<uint64_t> m_Timer      = kNoTimer;
+        std::atomic<int>      m_Animations = 0;
+    };
+
+}  // namespace ugfx
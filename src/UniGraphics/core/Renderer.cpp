@@ -0,0 +1,602 @@
+#include "Renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+
+#include "DrawBounds.h"
+#include "SpriteBatch.h"
+
+namespace ugfx {
+
+    static constexpr size_t kMaxBoundedVertices = 4096;
+    static constexpr int    kBitmapFontFlag     = 1 << 24;  // bitmap font ids, apart from the backend's font ids
+
+    Renderer::Renderer(FrameStats* stats) : m_Stats(stats ? stats : &m_LocalStats) {
+    }
+
+    Renderer::~Renderer() {
+        ReleaseBitmapFonts();
+    }
+
+    void Renderer::BeginDrawing() {
+        m_FrameStart = std::chrono::steady_clock::now();
+        m_Stats->ResetFrame();
+        m_Queue.Clear();
+        m_Layouts.NextFrame();
+        m_ClipIndex = 0;
+        BeginFrame();
+
+        m_Viewport = GetViewport();
+        UpdateCullRect();
+    }
+
+    void Renderer::EndDrawing() {
+        Flush();
+        const auto present = std::chrono::steady_clock::now();
+        m_Stats->cpuTimeMs = std::chrono::duration<float, std::milli>(present - m_FrameStart).count();
+        EndFrame();
+        m_Stats->presentWaitMs = static_cast<float>(MillisecondsSince(present));
+        if (m_Stats->inputTimestamp != 0) {
+            m_Stats->inputLatencyMs = static_cast<float>(SteadyNanoseconds() - m_Stats->inputTimestamp) / 1e6f;
+            m_Stats->inputTimestamp = 0;
+        }
+        if (m_Stats->pointerTimestamp != 0) {
+            m_Stats->pointerLatencyMs = static_cast<float>(SteadyNanoseconds() - m_Stats->pointerTimestamp) / 1e6f;
+            m_Stats->pointerTimestamp = 0;
+        }
+
+        // Render time includes the present call, where a GPU-bound frame ends up waiting. A frame cap lengthens
+        // the budget so its wait doesn't read as load.
+        if (m_Resolution.enabled) {
+            const float budget = m_Stats->targetFps > 0 ? 1000.0f / static_cast<float>(m_Stats->targetFps) : 0.0f;
+            m_ResolutionController.Update(m_Stats->cpuTimeMs + m_Stats->presentWaitMs, budget);
+        }
+
+        StartupStats& startup = m_Stats->startup;
+        if (startup.firstPresent == 0.0 && startup.origin != std::chrono::steady_clock::time_point{})
+            startup.firstPresent = MillisecondsSince(startup.origin);
+    }
+
+    void Renderer::SetDynamicResolution(const DynamicResolution& settings) {
+        m_Resolution = settings;
+        m_ResolutionController.Configure(settings.targetFrameMs, settings.minScale, settings.maxScale);
+    }
+
+    void Renderer::Clear(Color color) {
+        Flush();  // queued draws belong before the clear
+        RenderClear(color);
+    }
+
+    void Renderer::SetBlendMode(BlendMode mode) {
+        m_BlendMode = mode;
+        ApplyBlendMode(mode);
+    }
+
+    void Renderer::SetClipRect(Rectangle rect) {
+        m_ClipRect    = rect;
+        m_ClipEnabled = true;
+        m_ClipIndex   = 0;
+        ApplyClipRect(&m_ClipRect);
+        UpdateCullRect();
+    }
+
+    void Renderer::ClearClipRect() {
+        m_ClipEnabled = false;
+        m_ClipIndex   = 0;
+        ApplyClipRect(nullptr);
+        UpdateCullRect();
+    }
+
+    void Renderer::SetDrawSorting(bool enabled) {
+        if (m_Sorting && !enabled)
+            Flush();
+        m_Sorting = enabled;
+    }
+
+    void Renderer::PushLayer(int layer) {
+        m_Layers.push_back(layer);
+    }
+
+    void Renderer::PopLayer() {
+        if (!m_Layers.empty())
+            m_Layers.pop_back();
+    }
+
+    void Renderer::UpdateCullRect() {
+        m_CullRect = m_Viewport;
+        if (!m_ClipEnabled)
+            return;
+
+        float left   = std::max(m_CullRect.x, m_ClipRect.x);
+        float top    = std::max(m_CullRect.y, m_ClipRect.y);
+        float right  = std::min(m_CullRect.x + m_CullRect.width, m_ClipRect.x + m_ClipRect.width);
+        float bottom = std::min(m_CullRect.y + m_CullRect.height, m_ClipRect.y + m_ClipRect.height);
+        m_CullRect   = {left, top, std::max(0.0f, right - left), std::max(0.0f, bottom - top)};
+    }
+
+    // Conservative: bounds only need to contain what the draw touches.
+    bool Renderer::Cull(const Rectangle& bounds) {
+        if (bounds.x < m_CullRect.x + m_CullRect.width && bounds.x + bounds.width > m_CullRect.x &&
+            bounds.y < m_CullRect.y + m_CullRect.height && bounds.y + bounds.height > m_CullRect.y)
+            return false;
+
+        ++m_Stats->drawsCulled;
+        return true;
+    }
+
+    DrawCommand& Renderer::Enqueue(DrawCommand::Type type, uint32_t state, const Rectangle& bounds) {
+        DrawCommand cmd;
+        cmd.type  = type;
+        cmd.blend = m_BlendMode;
+        if (m_ClipEnabled) {
+            if (m_ClipIndex == 0)
+                m_ClipIndex = m_Queue.PushClip(m_ClipRect);
+            cmd.clip = m_ClipIndex;
+        }
+        return m_Queue.Push(cmd, CurrentLayer(), state, bounds);
+    }
+
+    void Renderer::Flush() {
+        if (m_Queue.Empty())
+            return;
+
+        m_Queue.Sort();
+        m_Stats->drawsSorted += static_cast<uint32_t>(m_Queue.Size());
+
+        bool      first = true;
+        BlendMode blend = m_BlendMode;
+        uint16_t  clip  = 0;
+        for (uint32_t index : m_Queue.Order()) {
+            const DrawCommand& cmd = m_Queue.Command(index);
+            if (first || cmd.blend != blend) {
+                blend = cmd.blend;
+                ApplyBlendMode(blend);
+            }
+            if (first || cmd.clip != clip) {
+                clip = cmd.clip;
+                ApplyClipRect(clip ? &m_Queue.Clip(clip) : nullptr);
+            }
+            first = false;
+            Execute(cmd);
+        }
+
+        // Back to the state the caller set last
+        ApplyBlendMode(m_BlendMode);
+        ApplyClipRect(m_ClipEnabled ? &m_ClipRect : nullptr);
+
+        m_Queue.Clear();
+        m_ClipIndex = 0;
+    }
+
+    void Renderer::Execute(const DrawCommand& cmd) {
+        using Type = DrawCommand::Type;
+        switch (cmd.type) {
+            case Type::Pixel:
+                RenderPixel(cmd.p0, cmd.color);
+                break;
+            case Type::Line:
+                RenderLine(cmd.p0, cmd.p1, cmd.value0, cmd.color);
+                break;
+            case Type::Rectangle:
+                RenderRectangle(cmd.rect, cmd.color);
+                break;
+            case Type::RectangleLines:
+                RenderRectangleLines(cmd.rect, cmd.value0, cmd.color);
+                break;
+            case Type::Circle:
+                RenderCircle(cmd.p0, cmd.value0, cmd.color);
+                break;
+            case Type::Triangle:
+                RenderTriangle(cmd.p0, cmd.p1, cmd.p2, cmd.color);
+                break;
+            case Type::Texture:
+                RenderTexture(cmd.texture, cmd.p0, cmd.color);
+                break;
+            case Type::TextureRegion:
+                RenderTextureRegion(cmd.texture, cmd.rect, cmd.p0, cmd.color);
+                break;
+            case Type::TextureRegionPro:
+                RenderTextureRegion(cmd.texture, cmd.rect, cmd.dest, cmd.p0, cmd.value0, cmd.flip, cmd.color);
+                break;
+            case Type::TextureEx:
+                RenderTextureEx(cmd.texture, cmd.p0, cmd.p1, cmd.value0, cmd.value1, cmd.flip, cmd.color);
+                break;
+            case Type::Geometry:
+                RenderGeometry(cmd.texture, m_Queue.Vertices(cmd), m_Queue.Indices(cmd));
+                break;
+            case Type::Text:
+                m_TextScratch.assign(m_Queue.Text(cmd));
+                RenderText(cmd.font, m_TextScratch, cmd.p0, cmd.value0, cmd.color);
+                break;
+            case Type::TextObject:
+                RenderTextObject(TextObject{cmd.textObject}, cmd.p0);
+                break;
+        }
+    }
+
+    // ------------------- Shapes -------------------
+
+    void Renderer::DrawPixel(Vector2 pos, Color color) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = {pos.x, pos.y, 1.0f, 1.0f};
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderPixel(pos, color);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::Pixel, 0, bounds);
+        cmd.p0           = pos;
+        cmd.color        = color;
+    }
+
+    void Renderer::DrawLine(Vector2 start, Vector2 end, float thickness, Color color) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = BoundsOfPoints(start, end, thickness * 0.5f + 1.0f);
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderLine(start, end, thickness, color);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::Line, 0, bounds);
+        cmd.p0           = start;
+        cmd.p1           = end;
+        cmd.value0       = thickness;
+        cmd.color        = color;
+    }
+
+    void Renderer::DrawRectangle(Rectangle rec, Color color) {
+        ++m_Stats->drawCalls;
+        if (Cull(rec))
+            return;
+        if (!Deferred()) {
+            RenderRectangle(rec, color);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::Rectangle, 0, rec);
+        cmd.rect         = rec;
+        cmd.color        = color;
+    }
+
+    void Renderer::DrawRectangleLines(Rectangle rec, float thickness, Color color) {
+        ++m_Stats->drawCalls;
+        if (Cull(rec))
+            return;
+        if (!Deferred()) {
+            RenderRectangleLines(rec, thickness, color);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::RectangleLines, 0, rec);
+        cmd.rect         = rec;
+        cmd.value0       = thickness;
+        cmd.color        = color;
+    }
+
+    void Renderer::DrawCircle(Vector2 center, float radius, Color color) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = BoundsOfPoints(center, center, radius + 1.0f);
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderCircle(center, radius, color);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::Circle, 0, bounds);
+        cmd.p0           = center;
+        cmd.value0       = radius;
+        cmd.color        = color;
+    }
+
+    void Renderer::DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = BoundsOfTriangle(v1, v2, v3);
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderTriangle(v1, v2, v3, color);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::Triangle, 0, bounds);
+        cmd.p0           = v1;
+        cmd.p1           = v2;
+        cmd.p2           = v3;
+        cmd.color        = color;
+    }
+
+    // ------------------- Textures -------------------
+
+    void Renderer::DrawTexture(Texture tex, Vector2 pos, Color tint) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = {pos.x, pos.y, static_cast<float>(tex.width), static_cast<float>(tex.height)};
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderTexture(tex, pos, tint);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::Texture, static_cast<uint32_t>(tex.id), bounds);
+        cmd.texture      = tex;
+        cmd.p0           = pos;
+        cmd.color        = tint;
+    }
+
+    void Renderer::DrawTextureRegion(Texture tex, Rectangle src, Vector2 dst, Color tint) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = {dst.x, dst.y, std::abs(src.width), std::abs(src.height)};  // negative sizes flip
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderTextureRegion(tex, src, dst, tint);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::TextureRegion, static_cast<uint32_t>(tex.id), bounds);
+        cmd.texture      = tex;
+        cmd.rect         = src;
+        cmd.p0           = dst;
+        cmd.color        = tint;
+    }
+
+    void Renderer::DrawTextureRegion(Texture texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation,
+                                     Flip flip, Color tint) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = BoundsOfRotatedQuad({dest.x, dest.y}, origin, dest.width, dest.height);
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderTextureRegion(texture, src, dest, origin, rotation, flip, tint);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::TextureRegionPro, static_cast<uint32_t>(texture.id), bounds);
+        cmd.texture      = texture;
+        cmd.rect         = src;
+        cmd.dest         = dest;
+        cmd.p0           = origin;
+        cmd.value0       = rotation;
+        cmd.flip         = flip;
+        cmd.color        = tint;
+    }
+
+    void Renderer::DrawTextureEx(Texture tex, Vector2 pos, Vector2 origin, float rotation, float scale, Flip flip,
+                                 Color tint) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds =
+            BoundsOfRotatedQuad(pos, {origin.x * scale, origin.y * scale}, tex.width * scale, tex.height * scale);
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderTextureEx(tex, pos, origin, rotation, scale, flip, tint);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::TextureEx, static_cast<uint32_t>(tex.id), bounds);
+        cmd.texture      = tex;
+        cmd.p0           = pos;
+        cmd.p1           = origin;
+        cmd.value0       = rotation;
+        cmd.value1       = scale;
+        cmd.flip         = flip;
+        cmd.color        = tint;
+    }
+
+    void Renderer::DrawGeometry(Texture tex, std::span<const Vertex2D> vertices, std::span<const int> indices) {
+        if (vertices.empty())
+            return;
+        ++m_Stats->drawCalls;
+
+        // Big batches come from systems that cull for themselves (tile maps, scenes, particles); skip the bounds
+        // pass for them and let them keep their submission position when sorting.
+        Rectangle bounds = vertices.size() <= kMaxBoundedVertices ? BoundsOfVertices(vertices) : kUnboundedRect;
+        if (!IsUnbounded(bounds) && Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderGeometry(tex, vertices, indices);
+            return;
+        }
+
+        uint32_t     state = tex.id > 0 ? static_cast<uint32_t>(tex.id) : 0u;
+        DrawCommand& cmd   = Enqueue(DrawCommand::Type::Geometry, state, bounds);
+        cmd.texture        = tex;
+        m_Queue.PushVertices(cmd, vertices, indices);
+    }
+
+    void Renderer::DrawSprites(Texture atlas, std::span<const Rectangle> regions, const SpriteArrays& sprites) {
+        if (atlas.id <= 0 || sprites.x.empty())
+            return;
+
+        Vector2 texSize = {static_cast<float>(atlas.width), static_cast<float>(atlas.height)};
+        size_t  count   = BuildSpriteQuads(sprites, regions, texSize, m_SpriteVertices);
+        if (count == 0)
+            return;
+
+        size_t kept = CullSpriteQuads(m_SpriteVertices, count, m_CullRect);
+        m_Stats->drawsCulled += static_cast<uint32_t>(count - kept);
+        if (kept == 0)
+            return;
+
+        BuildQuadIndices(kept, m_QuadIndices);
+        DrawGeometry(atlas, m_SpriteVertices, std::span<const int>(m_QuadIndices.data(), kept * 6));
+    }
+
+    // ------------------- Text -------------------
+
+    // Text extents are unknown until the backend rasterizes it, so text never moves across other draws in its layer.
+    static constexpr uint32_t kTextState = 1u << 19;
+
+    // Text grows right and down from its position; anything further can be culled without measuring it.
+    bool Renderer::CullText(Vector2 pos) {
+        if (pos.x < m_CullRect.x + m_CullRect.width && pos.y < m_CullRect.y + m_CullRect.height)
+            return false;
+
+        ++m_Stats->drawsCulled;
+        return true;
+    }
+
+    void Renderer::DrawText(Font font, const std::string& text, Vector2 pos, Color color) {
+        DrawText(font, text, pos, 0.0f, color);
+    }
+
+    void Renderer::DrawText(const std::string& text, Vector2 pos, int fontSize, Color color) {
+        DrawText(Font{}, text, pos, static_cast<float>(fontSize), color);
+    }
+
+    void Renderer::DrawText(Font font, const std::string& text, Vector2 pos, float fontSize, Color color) {
+        if (BitmapFont* bitmap = GetBitmapFont(font)) {
+            DrawBitmapText(*bitmap, text, pos, fontSize, color);
+            return;
+        }
+
+        ++m_Stats->drawCalls;
+        if (CullText(pos))
+            return;
+        if (!Deferred()) {
+            RenderText(font, text, pos, fontSize, color);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::Text, kTextState | (static_cast<uint32_t>(font.id) & 0xFFFFu),
+                                   kUnboundedRect);
+        cmd.font         = font;
+        cmd.p0           = pos;
+        cmd.value0       = fontSize;
+        cmd.color        = color;
+        m_Queue.PushText(cmd, text);
+    }
+
+    // Unlike plain text the extents are known, so text objects cull and sort like textured quads.
+    static constexpr uint32_t kTextObjectState = 1u << 18;
+
+    void Renderer::DrawTextObject(TextObject object, Vector2 pos) {
+        ++m_Stats->drawCalls;
+        Rectangle bounds = {pos.x + object.bounds.x, pos.y + object.bounds.y, object.bounds.width,
+                            object.bounds.height};
+        if (Cull(bounds))
+            return;
+        if (!Deferred()) {
+            RenderTextObject(object, pos);
+            return;
+        }
+
+        DrawCommand& cmd = Enqueue(DrawCommand::Type::TextObject,
+                                   kTextObjectState | (static_cast<uint32_t>(object.id) & 0xFFFFu), bounds);
+        cmd.textObject   = object.id;
+        cmd.p0           = pos;
+    }
+
+    // ------------------- Bitmap fonts -------------------
+
+    Font Renderer::LoadBitmapFont(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "Failed to open bitmap font: " << path << std::endl;
+            return {};
+        }
+        const std::string descriptor{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        auto font = std::make_unique<BitmapFont>();
+        if (!font->Parse(descriptor)) {
+            std::cerr << "Failed to parse bitmap font: " << path << std::endl;
+            return {};
+        }
+
+        // Page files are named relative to the descriptor
+        const std::filesystem::path dir = std::filesystem::path(path).parent_path();
+        for (const std::string& pageFile : font->PageFiles()) {
+            Texture page = LoadTexture((dir / pageFile).string());
+            if (page.id <= 0) {
+                std::cerr << "Failed to load bitmap font page: " << pageFile << std::endl;
+                for (Texture loaded : font->Pages())
+                    UnloadTexture(loaded);
+                return {};
+            }
+            font->Pages().push_back(page);
+        }
+        return {kBitmapFontFlag | m_BitmapFonts.Add(font.release())};
+    }
+
+    BitmapFont* Renderer::GetBitmapFont(Font font) {
+        return font.id > 0 && (font.id & kBitmapFontFlag) ? m_BitmapFonts.Get(font.id & ~kBitmapFontFlag) : nullptr;
+    }
+
+    bool Renderer::UnloadBitmapFont(Font font) {
+        BitmapFont* bitmap = GetBitmapFont(font);
+        if (!bitmap)
+            return false;
+        for (Texture page : bitmap->Pages())
+            UnloadTexture(page);
+        m_BitmapFonts.Remove(font.id & ~kBitmapFontFlag);
+        delete bitmap;
+        return true;
+    }
+
+    // Page textures belong to the backend, which releases them with the rest of its textures
+    void Renderer::ReleaseBitmapFonts() {
+        m_BitmapFonts.Clear([](BitmapFont* font) { delete font; });
+    }
+
+    // The DrawSprites path: quads expanded into reused buffers, culled, then one submission per page touched.
+    void Renderer::DrawBitmapText(BitmapFont& font, std::string_view text, Vector2 pos, float fontSize, Color color) {
+        const float                 scale = fontSize > 0.0f ? fontSize / static_cast<float>(font.BaseSize()) : 1.0f;
+        const std::vector<Texture>& pages = font.Pages();
+        for (size_t page = 0; page < pages.size(); ++page) {
+            m_SpriteVertices.clear();
+            size_t count = font.BuildQuads(text, pos, scale, color, static_cast<int>(page), m_SpriteVertices);
+            if (count == 0)
+                continue;
+
+            size_t kept = CullSpriteQuads(m_SpriteVertices, count, m_CullRect);
+            m_Stats->drawsCulled += static_cast<uint32_t>(count - kept);
+            if (kept == 0)
+                continue;
+
+            BuildQuadIndices(kept, m_QuadIndices);
+            DrawGeometry(pages[page], m_SpriteVertices, std::span<const int>(m_QuadIndices.data(), kept * 6));
+        }
+    }
+
+    // ------------------- Layout -------------------
+
+    const TextLayout* Renderer::Layout(Font font, const std::string& text, float fontSize, const TextOptions& options) {
+        IGlyphMetrics* metrics = GetBitmapFont(font);
+        if (!metrics)
+            metrics = GetGlyphMetrics(font, fontSize);
+        if (!metrics)
+            return nullptr;
+        return &m_Layouts.Get(font.id, *metrics, text, fontSize, options);
+    }
+
+    Vector2 Renderer::MeasureText(Font font, const std::string& text, float fontSize, const TextOptions& options) {
+        const TextLayout* layout = Layout(font, text, fontSize, options);
+        return layout ? layout->size : Vector2{0.0f, 0.0f};
+    }
+
+    // Each line goes through the plain DrawText path, so it batches, sorts and culls like any other text.
+    void Renderer::DrawText(Font font, const std::string& text, Vector2 pos, float fontSize,
+                            const TextOptions& options, Color color) {
+        const TextLayout* layout = Layout(font, text, fontSize, options);
+        if (!layout)
+            return;
+
+        for (const TextLine& line : layout->lines) {
+            if (line.end == line.begin)
+                continue;
+            m_LineScratch.assign(text, line.begin, line.end - line.begin);
+            DrawText(font, m_LineScratch, {pos.x + line.x, pos.y + line.y}, fontSize, color);
+        }
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,100 @@
+#include "SdfGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ugfx {
+
+    namespace {
+
+        struct Offset {
+            int16_t dx, dy;
+            int     Dist2() const { return dx * dx + dy * dy; }
+        };
+
+        constexpr Offset kFar = {9999, 9999};
+
+        // Eight-point sequential signed Euclidean distance transform over one grid, in place.
+        class DistanceGrid {
+           public:
+            DistanceGrid(int width, int height) : m_Width(width), m_Height(height), m_Cells(width * height, kFar) {}
+
+            void Set(int x, int y, Offset o) { m_Cells[y * m_Width + x] = o; }
+            int  Dist2(int x, int y) const { return m_Cells[y * m_Width + x].Dist2(); }
+
+            void Transform() {
+                for (int y = 0; y < m_Height; ++y) {
+                    for (int x = 0; x < m_Width; ++x) {
+                        Compare(x, y, -1, 0);
+                        Compare(x, y, 0, -1);
+                        Compare(x, y, -1, -1);
+                        Compare(x, y, 1, -1);
+                    }
+                    for (int x = m_Width - 1; x >= 0; --x)
+                        Compare(x, y, 1, 0);
+                }
+                for (int y = m_Height - 1; y >= 0; --y) {
+                    for (int x = m_Width - 1; x >= 0; --x) {
+                        Compare(x, y, 1, 0);
+                        Compare(x, y, 0, 1);
+                        Compare(x, y, -1, 1);
+                        Compare(x, y, 1, 1);
+                    }
+                    for (int x = 0; x < m_Width; ++x)
+                        Compare(x, y, -1, 0);
+                }
+            }
+
+           private:
+            void Compare(int x, int y, int ox, int oy) {
+                int nx = x + ox, ny = y + oy;
+                if (nx < 0 || ny < 0 || nx >= m_Width || ny >= m_Height)
+                    return;
+
+                Offset other = m_Cells[ny * m_Width + nx];
+                other.dx     = static_cast<int16_t>(other.dx + ox);
+                other.dy     = static_cast<int16_t>(other.dy + oy);
+
+                Offset& self = m_Cells[y * m_Width + x];
+                if (other.Dist2() < self.Dist2())
+                    self = other;
+            }
+
+            int                 m_Width, m_Height;
+            std::vector<Offset> m_Cells;
+        };
+
+    }  // namespace
+
+    void GenerateSdf(std::span<const uint8_t> coverage, int width, int height, float spread,
+                     std::vector<uint8_t>& out) {
+        out.assign(static_cast<size_t>(width) * height, 0);
+        if (width <= 0 || height <= 0 || coverage.size() < out.size())
+            return;
+
+        // inside: distance to the nearest outside pixel, outside: distance to the nearest inside pixel
+        DistanceGrid toOutside(width, height), toInside(width, height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (coverage[y * width + x] >= 128)
+                    toInside.Set(x, y, {0, 0});
+                else
+                    toOutside.Set(x, y, {0, 0});
+            }
+        }
+        toOutside.Transform();
+        toInside.Transform();
+
+        // The outline lies half a pixel between the two sets
+        const float scale = 127.0f / std::max(spread, 1.0f);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                float d = std::sqrt(static_cast<float>(toOutside.Dist2(x, y))) -
+                          std::sqrt(static_cast<float>(toInside.Dist2(x, y)));
+                d += d > 0.0f ? -0.5f : 0.5f;
+                out[y * width + x] = static_cast<uint8_t>(std::clamp(128.0f + d * scale, 0.0f, 255.0f));
+            }
+        }
+    }
+
+}  // namespace ugfx
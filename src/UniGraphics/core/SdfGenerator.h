@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ugfx {
+
+    // Converts an 8-bit coverage bitmap into a signed distance field of the same size using 8SSEDT.
+    // Output is 128 on the outline, rising inside; spread is the distance in pixels mapped to the full range.
+    void GenerateSdf(std::span<const uint8_t> coverage, int width, int height, float spread, std::vector<uint8_t>& out);
+
+}  // namespace ugfx
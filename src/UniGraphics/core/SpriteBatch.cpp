@@ -0,0 +1,150 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+
+#include "SimdMath.h"
+
+namespace ugfx {
+
+    size_t BuildSpriteQuads(const SpriteArrays& sprites, std::span<const Rectangle> regions, Vector2 textureSize,
+                            std::vector<Vertex2D>& vertices) {
+        using namespace simd;
+
+        const size_t count = sprites.x.size();
+        if (sprites.y.size() < count || textureSize.x <= 0.0f || textureSize.y <= 0.0f) {
+            vertices.clear();
+            return 0;
+        }
+
+        const bool hasRotation = sprites.rotation.size() >= count;
+        const bool hasScale    = sprites.scale.size() >= count;
+        const bool hasTint     = sprites.tint.size() >= count;
+        const bool hasRegion   = sprites.region.size() >= count && !regions.empty();
+
+        // Missing or out-of-range region indices use region 0, as SpriteScene assumes for its bounds
+        const Rectangle  fullRegion    = {0.0f, 0.0f, textureSize.x, textureSize.y};
+        const Rectangle* defaultRegion = regions.empty() ? &fullRegion : &regions[0];
+        const float      invTexW       = 1.0f / textureSize.x;
+        const float      invTexH       = 1.0f / textureSize.y;
+        const Color      white         = {255, 255, 255, 255};
+
+        vertices.resize(count * 4);
+        Vertex2D* out = vertices.data();
+
+        const Float4 originX    = Set1(sprites.origin.x);
+        const Float4 originY    = Set1(sprites.origin.y);
+        const Float4 zero       = Set1(0.0f);
+        const Float4 one        = Set1(1.0f);
+        const Float4 degToTurns = Set1(1.0f / 360.0f);
+
+        for (size_t base = 0; base < count; base += 4) {
+            const size_t lanes = count - base < 4 ? count - base : 4;
+
+            alignas(16) float x[4] = {}, y[4] = {}, rot[4] = {}, scale[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+            alignas(16) float w[4] = {}, h[4] = {};
+            const Rectangle*  src[4] = {defaultRegion, defaultRegion, defaultRegion, defaultRegion};
+
+            for (size_t l = 0; l < lanes; ++l) {
+                const size_t i = base + l;
+                x[l]           = sprites.x[i];
+                y[l]           = sprites.y[i];
+                if (hasRotation)
+                    rot[l] = sprites.rotation[i];
+                if (hasScale)
+                    scale[l] = sprites.scale[i];
+                if (hasRegion && sprites.region[i] < regions.size())
+                    src[l] = &regions[sprites.region[i]];
+                w[l] = src[l]->width;
+                h[l] = src[l]->height;
+            }
+
+            Float4 sn, cs;
+            SinCosTurns(Mul(Load(rot), degToTurns), sn, cs);
+
+            Float4 s      = Load(scale);
+            Float4 sw     = Mul(Load(w), s);
+            Float4 sh     = Mul(Load(h), s);
+            Float4 left   = Mul(Sub(zero, originX), sw);
+            Float4 right  = Mul(Sub(one, originX), sw);
+            Float4 top    = Mul(Sub(zero, originY), sh);
+            Float4 bottom = Mul(Sub(one, originY), sh);
+
+            Float4 px = Load(x);
+            Float4 py = Load(y);
+
+            Float4 leftC = Mul(left, cs), leftS = Mul(left, sn);
+            Float4 rightC = Mul(right, cs), rightS = Mul(right, sn);
+            Float4 topC = Mul(top, cs), topS = Mul(top, sn);
+            Float4 bottomC = Mul(bottom, cs), bottomS = Mul(bottom, sn);
+
+            // corner = pos + R * local, R = [c -s; s c]
+            alignas(16) float cx[4][4], cy[4][4];
+            Store(cx[0], Add(px, Sub(leftC, topS)));
+            Store(cy[0], Add(py, Add(leftS, topC)));
+            Store(cx[1], Add(px, Sub(rightC, topS)));
+            Store(cy[1], Add(py, Add(rightS, topC)));
+            Store(cx[2], Add(px, Sub(leftC, bottomS)));
+            Store(cy[2], Add(py, Add(leftS, bottomC)));
+            Store(cx[3], Add(px, Sub(rightC, bottomS)));
+            Store(cy[3], Add(py, Add(rightS, bottomC)));
+
+            for (size_t l = 0; l < lanes; ++l) {
+                const Rectangle& r    = *src[l];
+                const Color      tint = hasTint ? sprites.tint[base + l] : white;
+
+                float u0 = r.x * invTexW, u1 = (r.x + r.width) * invTexW;
+                float v0 = r.y * invTexH, v1 = (r.y + r.height) * invTexH;
+
+                Vertex2D* v = out + (base + l) * 4;
+                v[0]        = {{cx[0][l], cy[0][l]}, tint, {u0, v0}};
+                v[1]        = {{cx[1][l], cy[1][l]}, tint, {u1, v0}};
+                v[2]        = {{cx[2][l], cy[2][l]}, tint, {u0, v1}};
+                v[3]        = {{cx[3][l], cy[3][l]}, tint, {u1, v1}};
+            }
+        }
+
+        return count;
+    }
+
+    size_t CullSpriteQuads(std::vector<Vertex2D>& vertices, size_t quadCount, const Rectangle& view) {
+        const float right  = view.x + view.width;
+        const float bottom = view.y + view.height;
+
+        size_t kept = 0;
+        for (size_t q = 0; q < quadCount; ++q) {
+            const Vertex2D* v = vertices.data() + q * 4;
+
+            float minX = std::min({v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x});
+            float maxX = std::max({v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x});
+            float minY = std::min({v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y});
+            float maxY = std::max({v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y});
+            if (maxX <= view.x || minX >= right || maxY <= view.y || minY >= bottom)
+                continue;
+
+            if (kept != q)
+                std::copy(v, v + 4, vertices.data() + kept * 4);
+            ++kept;
+        }
+        vertices.resize(kept * 4);
+        return kept;
+    }
+
+    void BuildQuadIndices(size_t quadCount, std::vector<int>& indices) {
+        size_t built = indices.size() / 6;
+        if (built >= quadCount)
+            return;
+
+        indices.resize(quadCount * 6);
+        for (size_t q = built; q < quadCount; ++q) {
+            int  v = static_cast<int>(q * 4);
+            int* i = indices.data() + q * 6;
+            i[0]   = v;
+            i[1]   = v + 1;
+            i[2]   = v + 2;
+            i[3]   = v + 2;
+            i[4]   = v + 1;
+            i[5]   = v + 3;
+        }
+    }
+
+}  // namespace ugfx
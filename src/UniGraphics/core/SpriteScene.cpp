@@ -0,0 +1,336 @@
+#include "SpriteScene.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ugfx {
+
+    static constexpr float kDegToRad = 3.14159265358979323846f / 180.0f;
+
+    SpriteScene::SpriteScene(Texture atlas, std::span<const Rectangle> regions, float cellSize)
+        : m_Atlas(atlas), m_Regions(regions.begin(), regions.end()) {
+        if (cellSize > 0.0f) {
+            m_CellSize    = cellSize;
+            m_InvCellSize = 1.0f / cellSize;
+        }
+    }
+
+    uint64_t SpriteScene::CellKey(float x, float y) const {
+        int32_t cx = static_cast<int32_t>(std::floor(x * m_InvCellSize));
+        int32_t cy = static_cast<int32_t>(std::floor(y * m_InvCellSize));
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    float SpriteScene::RadiusOf(uint32_t dense) const {
+        float w = static_cast<float>(m_Atlas.width), h = static_cast<float>(m_Atlas.height);
+        if (!m_Regions.empty()) {
+            const Rectangle& r = m_Regions[m_Region[dense] < m_Regions.size() ? m_Region[dense] : 0];
+            w                  = std::abs(r.width);
+            h                  = std::abs(r.height);
+        }
+        float ox = std::max(m_Origin.x, 1.0f - m_Origin.x) * w;
+        float oy = std::max(m_Origin.y, 1.0f - m_Origin.y) * h;
+        return std::hypot(ox, oy) * std::abs(m_Scale[dense]);
+    }
+
+    Rectangle SpriteScene::BoundsOf(uint32_t dense) const {
+        float w = static_cast<float>(m_Atlas.width), h = static_cast<float>(m_Atlas.height);
+        if (!m_Regions.empty()) {
+            const Rectangle& r = m_Regions[m_Region[dense] < m_Regions.size() ? m_Region[dense] : 0];
+            w                  = std::abs(r.width);
+            h                  = std::abs(r.height);
+        }
+        const float s = m_Scale[dense];
+        const float a = m_Rotation[dense] * kDegToRad;
+        const float c = std::cos(a), sn = std::sin(a);
+
+        // Corner offsets from the pivot, rotated; the extent along each axis is symmetric per edge pair
+        const float x0 = -m_Origin.x * w * s, x1 = (1.0f - m_Origin.x) * w * s;
+        const float y0 = -m_Origin.y * h * s, y1 = (1.0f - m_Origin.y) * h * s;
+
+        const float cx[4] = {x0, x1, x0, x1};
+        const float cy[4] = {y0, y0, y1, y1};
+        float       minX = 0.0f, maxX = 0.0f, minY = 0.0f, maxY = 0.0f;
+        for (int i = 0; i < 4; ++i) {
+            float rx = cx[i] * c - cy[i] * sn;
+            float ry = cx[i] * sn + cy[i] * c;
+            minX     = i == 0 ? rx : std::min(minX, rx);
+            maxX     = i == 0 ? rx : std::max(maxX, rx);
+            minY     = i == 0 ? ry : std::min(minY, ry);
+            maxY     = i == 0 ? ry : std::max(maxY, ry);
+        }
+        return {m_X[dense] + minX, m_Y[dense] + minY, maxX - minX, maxY - minY};
+    }
+
+    void SpriteScene::Link(SpriteId id, uint64_t cell) {
+        std::vector<SpriteId>& ids = m_Cells[cell];
+        m_Slots[id].cell           = cell;
+        m_Slots[id].cellIndex      = static_cast<uint32_t>(ids.size());
+        ids.push_back(id);
+    }
+
+    void SpriteScene::Unlink(SpriteId id) {
+        auto it = m_Cells.find(m_Slots[id].cell);
+        if (it == m_Cells.end())
+            return;
+
+        // Swap-remove; empty cells are kept since moving sprites tend to come back
+        std::vector<SpriteId>& ids  = it->second;
+        SpriteId               last = ids.back();
+        ids[m_Slots[id].cellIndex]  = last;
+        m_Slots[last].cellIndex     = m_Slots[id].cellIndex;
+        ids.pop_back();
+    }
+
+    SpriteId SpriteScene::Add(const SpriteDesc& desc) {
+        SpriteId id;
+        if (!m_FreeIds.empty()) {
+            id = m_FreeIds.back();
+            m_FreeIds.pop_back();
+        } else {
+            id = static_cast<SpriteId>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+
+        uint32_t dense    = static_cast<uint32_t>(m_X.size());
+        m_Slots[id].dense = dense;
+        m_X.push_back(desc.position.x);
+        m_Y.push_back(desc.position.y);
+        m_Rotation.push_back(desc.rotation);
+        m_Scale.push_back(desc.scale);
+        m_Tint.push_back(desc.tint);
+        m_Region.push_back(desc.region);
+        m_DenseToId.push_back(id);
+        m_Radius.push_back(RadiusOf(dense));
+        m_MaxRadius = std::max(m_MaxRadius, m_Radius.back());
+
+        Link(id, CellKey(desc.position.x, desc.position.y));
+        return id;
+    }
+
+    void SpriteScene::Remove(SpriteId id) {
+        if (!Contains(id))
+            return;
+        Unlink(id);
+
+        // Swap-remove from the dense arrays
+        uint32_t dense = m_Slots[id].dense;
+        uint32_t last  = static_cast<uint32_t>(m_X.size() - 1);
+        if (dense != last) {
+            m_X[dense]                        = m_X[last];
+            m_Y[dense]                        = m_Y[last];
+            m_Rotation[dense]                 = m_Rotation[last];
+            m_Scale[dense]                    = m_Scale[last];
+            m_Radius[dense]                   = m_Radius[last];
+            m_Tint[dense]                     = m_Tint[last];
+            m_Region[dense]                   = m_Region[last];
+            m_DenseToId[dense]                = m_DenseToId[last];
+            m_Slots[m_DenseToId[dense]].dense = dense;
+        }
+        m_X.pop_back();
+        m_Y.pop_back();
+        m_Rotation.pop_back();
+        m_Scale.pop_back();
+        m_Radius.pop_back();
+        m_Tint.pop_back();
+        m_Region.pop_back();
+        m_DenseToId.pop_back();
+
+        m_Slots[id] = Slot{};
+        m_FreeIds.push_back(id);
+    }
+
+    void SpriteScene::Clear() {
+        m_X.clear();
+        m_Y.clear();
+        m_Rotation.clear();
+        m_Scale.clear();
+        m_Radius.clear();
+        m_Tint.clear();
+        m_Region.clear();
+        m_DenseToId.clear();
+        m_Slots.clear();
+        m_FreeIds.clear();
+        m_Cells.clear();
+        m_MaxRadius = 0.0f;
+    }
+
+    bool SpriteScene::Contains(SpriteId id) const {
+        return id < m_Slots.size() && m_Slots[id].dense != ~0u;
+    }
+
+    void SpriteScene::SetPosition(SpriteId id, Vector2 position) {
+        if (!Contains(id))
+            return;
+
+        uint32_t dense = m_Slots[id].dense;
+        m_X[dense]     = position.x;
+        m_Y[dense]     = position.y;
+
+        uint64_t cell = CellKey(position.x, position.y);
+        if (cell != m_Slots[id].cell) {
+            Unlink(id);
+            Link(id, cell);
+        }
+    }
+
+    void SpriteScene::SetRotation(SpriteId id, float rotation) {
+        if (Contains(id))
+            m_Rotation[m_Slots[id].dense] = rotation;
+    }
+
+    void SpriteScene::SetScale(SpriteId id, float scale) {
+        if (!Contains(id))
+            return;
+        uint32_t dense  = m_Slots[id].dense;
+        m_Scale[dense]  = scale;
+        m_Radius[dense] = RadiusOf(dense);
+        m_MaxRadius     = std::max(m_MaxRadius, m_Radius[dense]);
+    }
+
+    void SpriteScene::SetTint(SpriteId id, Color tint) {
+        if (Contains(id))
+            m_Tint[m_Slots[id].dense] = tint;
+    }
+
+    void SpriteScene::SetRegion(SpriteId id, uint16_t region) {
+        if (!Contains(id))
+            return;
+        uint32_t dense  = m_Slots[id].dense;
+        m_Region[dense] = region;
+        m_Radius[dense] = RadiusOf(dense);
+        m_MaxRadius     = std::max(m_MaxRadius, m_Radius[dense]);
+    }
+
+    void SpriteScene::SetOrigin(Vector2 origin) {
+        m_Origin    = origin;
+        m_MaxRadius = 0.0f;
+        for (uint32_t i = 0; i < m_X.size(); ++i) {
+            m_Radius[i] = RadiusOf(i);
+            m_MaxRadius = std::max(m_MaxRadius, m_Radius[i]);
+        }
+    }
+
+    SpriteDesc SpriteScene::Get(SpriteId id) const {
+        if (!Contains(id))
+            return {};
+        uint32_t dense = m_Slots[id].dense;
+        return {{m_X[dense], m_Y[dense]}, m_Rotation[dense], m_Scale[dense], m_Tint[dense], m_Region[dense]};
+    }
+
+    Rectangle SpriteScene::GetBounds(SpriteId id) const {
+        if (!Contains(id))
+            return {0.0f, 0.0f, 0.0f, 0.0f};
+        return BoundsOf(m_Slots[id].dense);
+    }
+
+    template <typename Fn>
+    void SpriteScene::ForEachCandidate(Rectangle area, Fn&& fn) const {
+        const float r  = m_MaxRadius;
+        const int   x0 = static_cast<int>(std::floor((area.x - r) * m_InvCellSize));
+        const int   y0 = static_cast<int>(std::floor((area.y - r) * m_InvCellSize));
+        const int   x1 = static_cast<int>(std::floor((area.x + area.width + r) * m_InvCellSize));
+        const int   y1 = static_cast<int>(std::floor((area.y + area.height + r) * m_InvCellSize));
+
+        auto visit = [&](const std::vector<SpriteId>& ids) {
+            for (SpriteId id : ids)
+                fn(m_Slots[id].dense);
+        };
+
+        // Zoomed far out the range can hold more cells than exist; walk the map instead
+        const int64_t rangeCells = static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+        if (rangeCells > static_cast<int64_t>(m_Cells.size())) {
+            for (const auto& [key, ids] : m_Cells) {
+                int cx = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+                int cy = static_cast<int32_t>(static_cast<uint32_t>(key));
+                if (cx >= x0 && cx <= x1 && cy >= y0 && cy <= y1)
+                    visit(ids);
+            }
+            return;
+        }
+
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+                auto     it  = m_Cells.find(key);
+                if (it != m_Cells.end())
+                    visit(it->second);
+            }
+        }
+    }
+
+    void SpriteScene::QueryPoint(Vector2 point, std::vector<SpriteId>& out) const {
+        out.clear();
+        ForEachCandidate({point.x, point.y, 0.0f, 0.0f}, [&](uint32_t dense) {
+            float dx = point.x - m_X[dense], dy = point.y - m_Y[dense];
+            float r  = m_Radius[dense];
+            if (dx * dx + dy * dy > r * r)
+                return;
+
+            float w = static_cast<float>(m_Atlas.width), h = static_cast<float>(m_Atlas.height);
+            if (!m_Regions.empty()) {
+                const Rectangle& region = m_Regions[m_Region[dense] < m_Regions.size() ? m_Region[dense] : 0];
+                w                       = std::abs(region.width);
+                h                       = std::abs(region.height);
+            }
+
+            // Into sprite space: undo rotation, then scale
+            float a  = -m_Rotation[dense] * kDegToRad;
+            float s  = m_Scale[dense];
+            float lx = (dx * std::cos(a) - dy * std::sin(a)) / s;
+            float ly = (dx * std::sin(a) + dy * std::cos(a)) / s;
+            lx += m_Origin.x * w;
+            ly += m_Origin.y * h;
+            if (lx >= 0.0f && lx < w && ly >= 0.0f && ly < h)
+                out.push_back(m_DenseToId[dense]);
+        });
+    }
+
+    void SpriteScene::QueryRect(Rectangle area, std::vector<SpriteId>& out) const {
+        out.clear();
+        ForEachCandidate(area, [&](uint32_t dense) {
+            Rectangle b = BoundsOf(dense);
+            if (b.x < area.x + area.width && b.x + b.width > area.x && b.y < area.y + area.height &&
+                b.y + b.height > area.y)
+                out.push_back(m_DenseToId[dense]);
+        });
+    }
+
+    size_t SpriteScene::Draw(IRenderer& renderer, Rectangle view) {
+        m_DrawX.clear();
+        m_DrawY.clear();
+        m_DrawRotation.clear();
+        m_DrawScale.clear();
+        m_DrawTint.clear();
+        m_DrawRegion.clear();
+
+        const float right = view.x + view.width, bottom = view.y + view.height;
+        ForEachCandidate(view, [&](uint32_t dense) {
+            float x = m_X[dense], y = m_Y[dense], r = m_Radius[dense];
+            if (x + r <= view.x || x - r >= right || y + r <= view.y || y - r >= bottom)
+                return;
+            m_DrawX.push_back(x - view.x);
+            m_DrawY.push_back(y - view.y);
+            m_DrawRotation.push_back(m_Rotation[dense]);
+            m_DrawScale.push_back(m_Scale[dense]);
+            m_DrawTint.push_back(m_Tint[dense]);
+            m_DrawRegion.push_back(m_Region[dense]);
+        });
+
+        if (m_DrawX.empty())
+            return 0;
+
+        SpriteArrays sprites;
+        sprites.x        = m_DrawX;
+        sprites.y        = m_DrawY;
+        sprites.rotation = m_DrawRotation;
+        sprites.scale    = m_DrawScale;
+        sprites.tint     = m_DrawTint;
+        if (!m_Regions.empty())
+            sprites.region = m_DrawRegion;
+        sprites.origin = m_Origin;
+        renderer.DrawSprites(m_Atlas, m_Regions, sprites);
+        return m_DrawX.size();
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "../interfaces/IRenderer.h"
+
+namespace ugfx {
+
+    using SpriteId = uint32_t;
+
+    inline constexpr SpriteId kInvalidSprite = ~0u;
+
+    struct SpriteDesc {
+        Vector2  position = {0.0f, 0.0f};
+        float    rotation = 0.0f;  // degrees
+        float    scale    = 1.0f;
+        Color    tint     = {255, 255, 255, 255};
+        uint16_t region   = 0;  // index into the scene's atlas regions
+    };
+
+    // Retained sprites of one atlas, indexed by a loose spatial hash: each sprite lives in the cell holding its
+    // pivot, and queries widen their search by the largest sprite radius. Moving a sprite only touches the hash
+    // when it crosses a cell border. Sprite data is kept in SoA arrays so visible sprites go to DrawSprites as is.
+    //
+    // Ids are reused after Remove. Draw order follows the grid rather than insertion order, so sprites that must
+    // stack predictably belong in separate scenes or layers.
+    class SpriteScene {
+       public:
+        explicit SpriteScene(Texture atlas, std::span<const Rectangle> regions = {}, float cellSize = 256.0f);
+
+        SpriteId Add(const SpriteDesc& desc);
+        void     Remove(SpriteId id);
+        void     Clear();
+        bool     Contains(SpriteId id) const;
+        size_t   Size() const { return m_X.size(); }
+
+        void SetPosition(SpriteId id, Vector2 position);
+        void SetRotation(SpriteId id, float rotation);
+        void SetScale(SpriteId id, float scale);
+        void SetTint(SpriteId id, Color tint);
+        void SetRegion(SpriteId id, uint16_t region);
+        void SetOrigin(Vector2 origin);  // pivot of every sprite, normalized to its region size
+
+        SpriteDesc Get(SpriteId id) const;
+        Rectangle  GetBounds(SpriteId id) const;  // axis-aligned bounds of the rotated sprite
+
+        // Hit tests; out is replaced with the matching ids.
+        void QueryPoint(Vector2 point, std::vector<SpriteId>& out) const;
+        void QueryRect(Rectangle area, std::vector<SpriteId>& out) const;
+
+        // Submits the sprites visible in view (world coordinates) in one DrawSprites call, translated so that
+        // view's top-left corner lands on the screen origin. Returns the number of sprites submitted.
+        size_t Draw(IRenderer& renderer, Rectangle view);
+
+       private:
+        struct Slot {
+            uint32_t dense     = ~0u;  // index into the SoA arrays, ~0u when free
+            uint32_t cellIndex = 0;
+            uint64_t cell      = 0;
+        };
+
+        uint64_t  CellKey(float x, float y) const;
+        float     RadiusOf(uint32_t dense) const;
+        Rectangle BoundsOf(uint32_t dense) const;
+        void      Link(SpriteId id, uint64_t cell);
+        void      Unlink(SpriteId id);
+
+        template <typename Fn>
+        void ForEachCandidate(Rectangle area, Fn&& fn) const;
+
+        Texture                m_Atlas;
+        std::vector<Rectangle> m_Regions;
+        Vector2                m_Origin      = {0.5f, 0.5f};
+        float                  m_CellSize    = 256.0f;
+        float                  m_InvCellSize = 1.0f / 256.0f;
+        float                  m_MaxRadius   = 0.0f;  // only grows, keeps queries conservative
+
+        // Dense SoA storage
+        std::vector<float>    m_X, m_Y, m_Rotation, m_Scale, m_Radius;
+        std::vector<Color>    m_Tint;
+        std::vector<uint16_t> m_Region;
+        std::vector<SpriteId> m_DenseToId;
+
+        std::vector<Slot>     m_Slots;
+        std::vector<SpriteId> m_FreeIds;
+
+        std::unordered_map<uint64_t, std::vector<SpriteId>> m_Cells;
+
+        // Draw scratch
+        std::vector<float>    m_DrawX, m_DrawY, m_DrawRotation, m_DrawScale;
+        std::vector<Color>    m_DrawTint;
+        std::vector<uint16_t> m_DrawRegion;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../CommonTypes.h"
+
+namespace ugfx {
+
+    // Least recently used cache of rendered text keyed by (font, size, color, text), holding at most a byte budget.
+    // Backends store whatever a redraw needs (a texture, glyph quads) and report its size on insert; evicted values
+    // go through the release callback.
+    template <typename Value>
+    class TextCache {
+       public:
+        using Release = std::function<void(Value&)>;
+
+        TextCache(size_t budget, Release release) : m_Budget(budget), m_Release(std::move(release)) {}
+        ~TextCache() { Clear(); }
+
+        TextCache(const TextCache&)            = delete;
+        TextCache& operator=(const TextCache&) = delete;
+
+        // Marks the entry as most recently used
+        Value* Find(int font, float fontSize, Color color, std::string_view text) {
+            auto it = m_Index.find(Hash(font, fontSize, color, text));
+            if (it == m_Index.end() || !it->second->Matches(font, fontSize, color, text))
+                return nullptr;
+            m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+            return &it->second->value;
+        }
+
+        // Replaces an entry with the same key, then evicts from the cold end until back under budget. The new
+        // entry itself is kept even if it alone exceeds the budget.
+        Value& Insert(int font, float fontSize, Color color, std::string_view text, Value value, size_t bytes) {
+            const uint64_t hash = Hash(font, fontSize, color, text);
+            if (auto it = m_Index.find(hash); it != m_Index.end())
+                Erase(it->second);
+
+            m_Entries.push_front({font, fontSize, color, std::string(text), std::move(value), bytes, hash});
+            m_Index[hash] = m_Entries.begin();
+            m_Bytes += bytes;
+            Trim(1);
+            return m_Entries.front().value;
+        }
+
+        // Drops everything rendered with a font, e.g. when it is unloaded
+        void EraseFont(int font) {
+            for (auto it = m_Entries.begin(); it != m_Entries.end();)
+                it = it->font == font ? Erase(it) : std::next(it);
+        }
+
+        void Clear() {
+            while (!m_Entries.empty())
+                Erase(std::prev(m_Entries.end()));
+        }
+
+        void SetBudget(size_t bytes) {
+            m_Budget = bytes;
+            Trim(0);
+        }
+
+        size_t Bytes() const { return m_Bytes; }
+        size_t Size() const { return m_Entries.size(); }
+
+       private:
+        struct Entry {
+            int         font;
+            float       fontSize;
+            Color       color;
+            std::string text;
+            Value       value;
+            size_t      bytes;
+            uint64_t    hash;
+
+            bool Matches(int f, float size, Color c, std::string_view t) const {
+                return font == f && fontSize == size && std::memcmp(&color, &c, sizeof(Color)) == 0 && text == t;
+            }
+        };
+
+        using Iterator = typename std::list<Entry>::iterator;
+
+        static uint64_t Hash(int font, float fontSize, Color color, std::string_view text) {
+            uint32_t sizeBits = 0, colorBits = 0;
+            std::memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+            std::memcpy(&colorBits, &color, sizeof(colorBits));
+            uint64_t h = std::hash<std::string_view>{}(text);
+            h ^= (static_cast<uint64_t>(static_cast<uint32_t>(font)) << 32 | sizeBits) + 0x9E3779B97F4A7C15ull +
+                 (h << 6) + (h >> 2);
+            h ^= colorBits + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            return h;
+        }
+
+        Iterator Erase(Iterator it) {
+            if (m_Release)
+                m_Release(it->value);
+            m_Bytes -= it->bytes;
+            m_Index.erase(it->hash);
+            return m_Entries.erase(it);
+        }
+
+        // Evicts least recently used entries, sparing the keep most recent ones
+        void Trim(size_t keep) {
+            while (m_Bytes > m_Budget && m_Entries.size() > keep)
+                Erase(std::prev(m_Entries.end()));
+        }
+
+        size_t                                 m_Budget = 0;
+        size_t                                 m_Bytes  = 0;
+        Release                                m_Release;
+        std::list<Entry>                       m_Entries;  // most recently used first
+        std::unordered_map<uint64_t, Iterator> m_Index;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,214 @@
+#include "TextLayout.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+#include "Utf8.h"
+
+namespace ugfx {
+
+    static void BreakByCodePoint(IGlyphMetrics& metrics, std::string_view text, float scale, float wrap,
+                                 std::vector<TextLine>& lines) {
+        TextLine line;
+        float    penX = 0.0f;
+        uint32_t prev = 0;
+
+        // Where the current line ends if nothing else fits: after its last non-space code point
+        uint32_t contentEnd   = 0;
+        float    contentWidth = 0.0f;
+
+        // Last space run on the line: the line can end before it and the next one start after it
+        bool     hasBreak   = false;
+        uint32_t breakEnd   = 0, breakNext = 0;
+        float    breakWidth = 0.0f;
+
+        auto finish = [&](uint32_t end, float width, uint32_t next) {
+            line.end   = end;
+            line.width = width;
+            lines.push_back(line);
+
+            line         = {};
+            line.begin   = next;
+            contentEnd   = next;
+            contentWidth = 0.0f;
+            penX         = 0.0f;
+            prev         = 0;
+            hasBreak     = false;
+        };
+
+        for (size_t i = 0; i < text.size();) {
+            const uint32_t start = static_cast<uint32_t>(i);
+            const uint32_t cp    = DecodeUtf8(text, i);
+            if (cp == '\n') {
+                finish(contentEnd, contentWidth, static_cast<uint32_t>(i));
+                continue;
+            }
+
+            const float advance = (prev ? metrics.Kerning(prev, cp) : 0.0f) * scale + metrics.Advance(cp) * scale;
+            if (cp == ' ') {
+                if (contentEnd > line.begin) {
+                    hasBreak   = true;
+                    breakEnd   = contentEnd;
+                    breakWidth = contentWidth;
+                    breakNext  = static_cast<uint32_t>(i);
+                }
+                penX += advance;
+                prev = cp;
+                continue;
+            }
+
+            // Only spaces never wrap; a line always keeps at least one code point
+            if (wrap > 0.0f && penX + advance > wrap && contentEnd > line.begin) {
+                if (hasBreak) {
+                    i = breakNext;
+                    finish(breakEnd, breakWidth, breakNext);
+                } else {
+                    i = start;
+                    finish(contentEnd, contentWidth, start);
+                }
+                continue;
+            }
+
+            prev         = cp;
+            contentEnd   = static_cast<uint32_t>(i);
+            contentWidth = penX + advance;
+            penX         = contentWidth;
+        }
+        finish(contentEnd, contentWidth, static_cast<uint32_t>(text.size()));
+    }
+
+    // Same breaks as BreakByCodePoint, but every candidate line is measured as one shaped run so widths match what
+    // the shaped draw path places
+    static void BreakShaped(IGlyphMetrics& metrics, std::string_view text, float scale, float wrap,
+                            std::vector<TextLine>& lines) {
+        auto measure = [&](uint32_t begin, uint32_t end) {
+            return metrics.MeasureRun(text.substr(begin, end - begin)) * scale;
+        };
+        auto push = [&](uint32_t begin, uint32_t end, float width) {
+            TextLine line;
+            line.begin = begin;
+            line.end   = end;
+            line.width = width;
+            lines.push_back(line);
+        };
+
+        size_t paragraph = 0;
+        for (;;) {
+            const size_t   newline = text.find('\n', paragraph);
+            const uint32_t last    = static_cast<uint32_t>(newline == std::string_view::npos ? text.size() : newline);
+
+            // The line ends after its last word; trailing spaces are measured with the next word only
+            uint32_t begin        = static_cast<uint32_t>(paragraph);
+            uint32_t contentEnd   = begin;
+            float    contentWidth = 0.0f;
+            for (uint32_t i = begin; i < last;) {
+                if (text[i] == ' ') {
+                    ++i;
+                    continue;
+                }
+                const uint32_t wordStart = i;
+                while (i < last && text[i] != ' ')
+                    ++i;
+
+                float width = measure(begin, i);
+                if (wrap > 0.0f && width > wrap && contentEnd > begin) {
+                    push(begin, contentEnd, contentWidth);
+                    begin = wordStart;
+                    width = measure(begin, i);
+                }
+
+                // A word wider than the wrap width on its own splits between code points, at least one per line
+                if (wrap > 0.0f && width > wrap) {
+                    size_t next = wordStart;
+                    DecodeUtf8(text, next);
+                    uint32_t fitEnd   = static_cast<uint32_t>(next);
+                    float    fitWidth = measure(begin, fitEnd);
+                    while (next < i) {
+                        DecodeUtf8(text, next);
+                        const float w = measure(begin, static_cast<uint32_t>(next));
+                        if (w > wrap) {
+                            push(begin, fitEnd, fitWidth);
+                            begin    = fitEnd;
+                            fitWidth = measure(begin, static_cast<uint32_t>(next));
+                        } else {
+                            fitWidth = w;
+                        }
+                        fitEnd = static_cast<uint32_t>(next);
+                    }
+                    width = fitWidth;
+                }
+                contentEnd   = i;
+                contentWidth = width;
+            }
+            push(begin, contentEnd, contentWidth);
+
+            if (newline == std::string_view::npos)
+                break;
+            paragraph = newline + 1;
+        }
+    }
+
+    void LayoutText(IGlyphMetrics& metrics, std::string_view text, float fontSize, const TextOptions& options,
+                    TextLayout& out) {
+        out.lines.clear();
+        const float scale      = fontSize > 0.0f ? fontSize / static_cast<float>(metrics.BaseSize()) : 1.0f;
+        const float lineHeight = metrics.LineHeight() * scale;
+        const float wrap       = options.wrapWidth;
+
+        if (metrics.ShapesRuns())
+            BreakShaped(metrics, text, scale, wrap, out.lines);
+        else
+            BreakByCodePoint(metrics, text, scale, wrap, out.lines);
+
+        float widest = 0.0f;
+        for (const TextLine& l : out.lines)
+            widest = std::max(widest, l.width);
+
+        const float box  = wrap > 0.0f ? wrap : widest;
+        const float step = lineHeight * options.lineSpacing;
+        for (size_t n = 0; n < out.lines.size(); ++n) {
+            TextLine& l = out.lines[n];
+            l.y         = step * static_cast<float>(n);
+            if (options.align == TextAlign::Center)
+                l.x = (box - l.width) * 0.5f;
+            else if (options.align == TextAlign::Right)
+                l.x = box - l.width;
+        }
+        out.size = {widest, step * static_cast<float>(out.lines.size() - 1) + lineHeight};
+    }
+
+    static void HashCombine(uint64_t& h, uint64_t v) {
+        h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    }
+
+    const TextLayout& TextLayoutCache::Get(int font, IGlyphMetrics& metrics, std::string_view text, float fontSize,
+                                           const TextOptions& options) {
+        uint64_t key = std::hash<std::string_view>{}(text);
+        HashCombine(key, static_cast<uint32_t>(font));
+        HashCombine(key, std::bit_cast<uint32_t>(fontSize));
+        HashCombine(key, std::bit_cast<uint32_t>(options.wrapWidth));
+        HashCombine(key, std::bit_cast<uint32_t>(options.lineSpacing));
+        HashCombine(key, static_cast<uint64_t>(options.align));
+
+        auto [it, inserted] = m_Entries.try_emplace(key);
+        Entry& e            = it->second;
+        if (inserted || e.font != font || e.fontSize != fontSize || e.options.wrapWidth != options.wrapWidth ||
+            e.options.lineSpacing != options.lineSpacing || e.options.align != options.align || e.text != text) {
+            e.font     = font;
+            e.fontSize = fontSize;
+            e.options  = options;
+            e.text.assign(text);
+            LayoutText(metrics, text, fontSize, options, e.layout);
+        }
+        e.lastUsed = m_Frame;
+        return e.layout;
+    }
+
+    void TextLayoutCache::NextFrame() {
+        if (m_Entries.size() > m_Capacity)
+            std::erase_if(m_Entries, [this](const auto& entry) { return entry.second.lastUsed < m_Frame; });
+        ++m_Frame;
+    }
+
+}  // namespace ugfx
@@ -0,0 +1,135 @@
+#include "TileMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "SpriteBatch.h"
+
+namespace ugfx {
+
+    TileMap::TileMap(Texture tileset, int tileWidth, int tileHeight, int columns, int rows, int chunkSize)
+        : m_Tileset(tileset),
+          m_TileWidth(std::max(1, tileWidth)),
+          m_TileHeight(std::max(1, tileHeight)),
+          m_Columns(std::max(0, columns)),
+          m_Rows(std::max(0, rows)),
+          m_ChunkSize(std::max(1, chunkSize)) {
+        m_ChunkColumns = (m_Columns + m_ChunkSize - 1) / m_ChunkSize;
+        m_ChunkRows    = (m_Rows + m_ChunkSize - 1) / m_ChunkSize;
+        m_TilesPerRow  = std::max(1, m_Tileset.width / m_TileWidth);
+
+        m_Tiles.assign(static_cast<size_t>(m_Columns) * m_Rows, -1);
+        m_Chunks.resize(static_cast<size_t>(m_ChunkColumns) * m_ChunkRows);
+    }
+
+    void TileMap::SetTile(int x, int y, int tile) {
+        if (x < 0 || y < 0 || x >= m_Columns || y >= m_Rows)
+            return;
+
+        int& current = m_Tiles[static_cast<size_t>(y) * m_Columns + x];
+        if (current == tile)
+            return;
+        current                                         = tile;
+        ChunkAt(x / m_ChunkSize, y / m_ChunkSize).dirty = true;
+    }
+
+    int TileMap::GetTile(int x, int y) const {
+        if (x < 0 || y < 0 || x >= m_Columns || y >= m_Rows)
+            return -1;
+        return m_Tiles[static_cast<size_t>(y) * m_Columns + x];
+    }
+
+    void TileMap::SetTiles(std::span<const int> tiles) {
+        if (tiles.size() != m_Tiles.size()) {
+            std::cerr << "TileMap::SetTiles expected " << m_Tiles.size() << " tiles, got " << tiles.size() << "\n";
+            return;
+        }
+        std::copy(tiles.begin(), tiles.end(), m_Tiles.begin());
+        for (Chunk& chunk : m_Chunks)
+            chunk.dirty = true;
+    }
+
+    void TileMap::SetTint(Color tint) {
+        m_Tint = tint;
+        for (Chunk& chunk : m_Chunks)
+            chunk.dirty = true;
+    }
+
+    Vector2 TileMap::WorldSize() const {
+        return {static_cast<float>(m_Columns * m_TileWidth), static_cast<float>(m_Rows * m_TileHeight)};
+    }
+
+    void TileMap::Bake(int cx, int cy) {
+        Chunk& chunk = ChunkAt(cx, cy);
+        chunk.vertices.clear();
+        chunk.dirty = false;
+        if (m_Tileset.width <= 0 || m_Tileset.height <= 0)
+            return;
+
+        const float invW = 1.0f / m_Tileset.width, invH = 1.0f / m_Tileset.height;
+        const float tw = static_cast<float>(m_TileWidth), th = static_cast<float>(m_TileHeight);
+
+        const int x0 = cx * m_ChunkSize, x1 = std::min(x0 + m_ChunkSize, m_Columns);
+        const int y0 = cy * m_ChunkSize, y1 = std::min(y0 + m_ChunkSize, m_Rows);
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                int tile = m_Tiles[static_cast<size_t>(y) * m_Columns + x];
+                if (tile < 0)
+                    continue;
+
+                float u0 = (tile % m_TilesPerRow) * tw * invW, u1 = u0 + tw * invW;
+                float v0 = (tile / m_TilesPerRow) * th * invH, v1 = v0 + th * invH;
+                float px = x * tw, py = y * th;
+
+                // TL, TR, BL, BR to match BuildQuadIndices
+                chunk.vertices.push_back({{px, py}, m_Tint, {u0, v0}});
+                chunk.vertices.push_back({{px + tw, py}, m_Tint, {u1, v0}});
+                chunk.vertices.push_back({{px, py + th}, m_Tint, {u0, v1}});
+                chunk.vertices.push_back({{px + tw, py + th}, m_Tint, {u1, v1}});
+            }
+        }
+    }
+
+    size_t TileMap::Draw(IRenderer& renderer, Rectangle view) {
+        if (m_Chunks.empty())
+            return 0;
+
+        const float chunkW = static_cast<float>(m_ChunkSize * m_TileWidth);
+        const float chunkH = static_cast<float>(m_ChunkSize * m_TileHeight);
+
+        const int cx0 = std::max(0, static_cast<int>(std::floor(view.x / chunkW)));
+        const int cy0 = std::max(0, static_cast<int>(std::floor(view.y / chunkH)));
+        const int cx1 = std::min(m_ChunkColumns - 1, static_cast<int>(std::floor((view.x + view.width) / chunkW)));
+        const int cy1 = std::min(m_ChunkRows - 1, static_cast<int>(std::floor((view.y + view.height) / chunkH)));
+
+        // Translate the cached world-space chunks into one screen-space batch
+        m_DrawVertices.clear();
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                Chunk& chunk = ChunkAt(cx, cy);
+                if (chunk.dirty)
+                    Bake(cx, cy);
+
+                size_t base = m_DrawVertices.size();
+                m_DrawVertices.resize(base + chunk.vertices.size());
+                Vertex2D* out = m_DrawVertices.data() + base;
+                for (const Vertex2D& v : chunk.vertices) {
+                    *out = v;
+                    out->position.x -= view.x;
+                    out->position.y -= view.y;
+                    ++out;
+                }
+            }
+        }
+
+        const size_t quads = m_DrawVertices.size() / 4;
+        if (quads == 0)
+            return 0;
+
+        BuildQuadIndices(quads, m_QuadIndices);
+        renderer.DrawGeometry(m_Tileset, m_DrawVertices, std::span<const int>(m_QuadIndices.data(), quads * 6));
+        return quads;
+    }
+
+}  // namespace ugfx
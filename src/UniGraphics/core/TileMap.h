@@ -0,0 +1,59 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "../interfaces/IRenderer.h"
+
+namespace ugfx {
+
+    // A grid of tile indices drawn from a tileset texture. The grid is split into square chunks whose quads are
+    // baked once into cached vertex buffers; SetTile only marks its chunk for rebuilding. Draw gathers the
+    // chunks overlapping the view into one DrawGeometry call.
+    //
+    // Tiles are numbered left to right, top to bottom across the tileset; a negative index is an empty cell.
+    class TileMap {
+       public:
+        TileMap(Texture tileset, int tileWidth, int tileHeight, int columns, int rows, int chunkSize = 32);
+
+        void SetTile(int x, int y, int tile);
+        int  GetTile(int x, int y) const;
+        void SetTiles(std::span<const int> tiles);  // row-major, columns * rows entries
+        void SetTint(Color tint);
+
+        int     Columns() const { return m_Columns; }
+        int     Rows() const { return m_Rows; }
+        Vector2 WorldSize() const;
+
+        // Draws the part of the map inside view (world coordinates) with view's top-left corner at the screen
+        // origin. Returns the number of tiles submitted.
+        size_t Draw(IRenderer& renderer, Rectangle view);
+
+       private:
+        struct Chunk {
+            std::vector<Vertex2D> vertices;  // world space, four per non-empty tile
+            bool                  dirty = true;
+        };
+
+        Chunk& ChunkAt(int cx, int cy) { return m_Chunks[cy * m_ChunkColumns + cx]; }
+        void   Bake(int cx, int cy);
+
+        Texture m_Tileset;
+        int     m_TileWidth    = 0;
+        int     m_TileHeight   = 0;
+        int     m_Columns      = 0;
+        int     m_Rows         = 0;
+        int     m_ChunkSize    = 32;
+        int     m_ChunkColumns = 0;
+        int     m_ChunkRows    = 0;
+        int     m_TilesPerRow  = 1;  // tiles per tileset row
+        Color   m_Tint         = {255, 255, 255, 255};
+
+        std::vector<int>   m_Tiles;
+        std::vector<Chunk> m_Chunks;
+
+        std::vector<Vertex2D> m_DrawVertices;
+        std::vector<int>      m_QuadIndices;
+    };
+
+}  // namespace ugfx
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace ugfx {
+
+    // Decodes the code point starting at text[i] and advances i past it. Malformed sequences yield U+FFFD and
+    // advance a single byte, so a decode loop always terminates.
+    inline uint32_t DecodeUtf8(std::string_view text, size_t& i) {
+        const uint8_t lead = static_cast<uint8_t>(text[i++]);
+        if (lead < 0x80)
+            return lead;
+
+        const int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+        if (extra < 0 || i + extra > text.size())
+            return 0xFFFD;
+
+        uint32_t cp = lead & (0x3F >> extra);
+        for (int n = 0; n < extra; ++n) {
+            const uint8_t c = static_cast<uint8_t>(text[i + n]);
+            if ((c & 0xC0) != 0x80)
+                return 0xFFFD;
+            cp = (cp << 6) | (c & 0x3F);
+        }
+        i += extra;
+        return cp;
+    }
+
+}  // namespace ugfx
@@ -1,8 +1,11 @@
 #pragma once
 
-#include <functional>
+#include <span>
 
 #include "../CommonTypes.h"
+#include "../core/EventBus.h"
+#include "../core/InputEvents.h"
+#include "../core/InputSnapshot.h"
 
 namespace ugfx {
 
@@ -10,17 +13,48 @@ namespace ugfx {
        public:
         virtual ~IInput() = default;
 
-        using EventCallback = std::function<void(void* event)>;
+        virtual void ProcessEvents(void* event) = 0;
+        virtual void BeginFrame()               = 0;
+        virtual void EndFrame()                 = 0;  // after the frame's events
 
-        virtual void ProcessEvents(void* event)                    = 0;
-        virtual void BeginFrame()                                  = 0;
-        virtual void RegisterEventCallback(EventCallback callback) = 0;
+        // The current frame's events, oldest first, valid until the next PollEvents
+        virtual std::span<const InputEvent> GetEvents() const = 0;
+
+        // Listeners for the same events, called from PollEvents once the frame's events are in
+        virtual EventBus& GetEventBus() = 0;
+
+        // Copies the frame's keyboard, mouse and gamepad state into out, leaving out.actions alone. Gamepads are
+        // included once the backend has them open (on SDL, from the first gamepad query).
+        virtual void Snapshot(InputSnapshot& out) const = 0;
 
         virtual bool  IsKeyPressed(Key key) const  = 0;
         virtual bool  IsKeyDown(Key key) const     = 0;
         virtual bool  IsKeyReleased(Key key) const = 0;
         virtual bool  IsKeyUp(Key key) const       = 0;
         virtual void* GetHandle() const            = 0;
+
+        // Mouse. Delta and wheel are summed over the frame's events.
+        virtual Vector2 GetMousePosition() const                        = 0;
+        virtual Vector2 GetMouseDelta() const                           = 0;
+        virtual Vector2 GetMouseWheel() const                           = 0;
+        virtual bool    IsMouseButtonDown(MouseButton button) const     = 0;
+        virtual bool    IsMouseButtonPressed(MouseButton button) const  = 0;
+        virtual bool    IsMouseButtonReleased(MouseButton button) const = 0;
+
+        // Samples the pointer again, for cursors and drag visuals drawn just before EndDrawing. Newer events stay
+        // queued for the next PollEvents. Main thread only.
+        virtual Vector2 ResamplePointer() = 0;
+
+        // Every mouse motion event in GetEvents and the event bus rather than one merged MouseMove per run of
+        // motion. Off by default; only backends that see individual motion events honor it.
+        virtual void SetRawMotion(bool enabled) = 0;
+
+        // Gamepads by slot, 0 being the first connected
+        virtual bool  IsGamepadAvailable(int gamepad) const                            = 0;
+        virtual float GetGamepadAxis(int gamepad, GamepadAxis axis) const              = 0;
+        virtual bool  IsGamepadButtonDown(int gamepad, GamepadButton button) const     = 0;
+        virtual bool  IsGamepadButtonPressed(int gamepad, GamepadButton button) const  = 0;
+        virtual bool  IsGamepadButtonReleased(int gamepad, GamepadButton button) const = 0;
     };
 
 }  // namespace ugfx
@@ -0,0 +1,197 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "UniGraphics/core/EmbeddedFont.h"
+
+// Usage: BakeBitmapFont <size> <output path without extension>
+// Bakes the embedded Lexend font at one pixel size into an AngelCode BMFont: <output>.fnt plus a single PNG page,
+// <output>_0.png, covering printable ASCII and Latin-1. Load the result with ITextRenderer::LoadBitmapFont.
+
+struct BakedGlyph {
+    uint32_t     codepoint = 0;
+    SDL_Surface* surface   = nullptr;  // ARGB8888, null for blank glyphs
+    SDL_Rect     ink       = {};       // non-transparent part of surface
+    int          x = 0, y = 0;         // position on the page
+    int          offsetX = 0, offsetY = 0;
+    int          advance = 0;
+};
+
+static constexpr int kPadding = 1;  // between glyphs on the page, so filtering never bleeds into a neighbour
+
+static bool BakeGlyph(TTF_Font* font, uint32_t codepoint, BakedGlyph& out) {
+    int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+    if (!TTF_GlyphIsProvided32(font, codepoint) ||
+        TTF_GlyphMetrics32(font, codepoint, &minX, &maxX, &minY, &maxY, &advance) != 0)
+        return false;
+
+    out.codepoint = codepoint;
+    out.advance   = advance;
+
+    // The surface spans the line height with the pen at its left edge, shifted for negative bearings
+    SDL_Surface* surf = TTF_RenderGlyph32_Blended(font, codepoint, {255, 255, 255, 255});
+    if (!surf)
+        return true;
+
+    int x0 = surf->w, y0 = surf->h, x1 = -1, y1 = -1;
+
+    const auto* pixels = static_cast<const uint8_t*>(surf->pixels);
+    for (int y = 0; y < surf->h; ++y) {
+        const auto* row = reinterpret_cast<const uint32_t*>(pixels + y * surf->pitch);
+        for (int x = 0; x < surf->w; ++x) {
+            if (row[x] >> 24) {
+                x0 = std::min(x0, x);
+                x1 = std::max(x1, x);
+                y0 = std::min(y0, y);
+                y1 = std::max(y1, y);
+            }
+        }
+    }
+    if (x1 < 0) {
+        SDL_FreeSurface(surf);
+        return true;
+    }
+
+    out.surface = surf;
+    out.ink     = {x0, y0, x1 - x0 + 1, y1 - y0 + 1};
+    out.offsetX = std::min(0, minX) + x0;
+    out.offsetY = y0;
+    return true;
+}
+
+// Shelf packing into a fixed width; returns the page height used
+static int Pack(std::vector<BakedGlyph>& glyphs, int width) {
+    std::vector<BakedGlyph*> order;
+    for (BakedGlyph& g : glyphs)
+        if (g.surface)
+            order.push_back(&g);
+    std::sort(order.begin(), order.end(), [](const BakedGlyph* a, const BakedGlyph* b) { return a->ink.h > b->ink.h; });
+
+    int x = 0, y = 0, shelf = 0;
+    for (BakedGlyph* g : order) {
+        if (x + g->ink.w + kPadding > width) {
+            x = 0;
+            y += shelf;
+            shelf = 0;
+        }
+        g->x = x;
+        g->y = y;
+        x += g->ink.w + kPadding;
+        shelf = std::max(shelf, g->ink.h + kPadding);
+    }
+    return y + shelf;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: BakeBitmapFont <size> <output path without extension>\n";
+        return 1;
+    }
+    const int                   size = std::atoi(argv[1]);
+    const std::filesystem::path out  = argv[2];
+    if (size <= 0) {
+        std::cerr << "Invalid size: " << argv[1] << "\n";
+        return 1;
+    }
+
+    if (TTF_Init() != 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        std::cerr << "SDL_ttf/SDL_image init failed: " << SDL_GetError() << "\n";
+        return 1;
+    }
+    const std::span<const uint8_t> data = ugfx::DefaultFontData();
+
+    SDL_RWops* rw   = data.empty() ? nullptr : SDL_RWFromConstMem(data.data(), static_cast<int>(data.size()));
+    TTF_Font*  font = rw ? TTF_OpenFontRW(rw, 1, size) : nullptr;
+    if (!font) {
+        std::cerr << "Failed to open the embedded font: " << TTF_GetError() << "\n";
+        return 1;
+    }
+
+    std::vector<BakedGlyph> glyphs;
+    for (uint32_t cp = 32; cp <= 255; ++cp) {
+        if (cp == 127)
+            cp = 160;  // skip DEL and the C1 controls
+        BakedGlyph glyph;
+        if (BakeGlyph(font, cp, glyph))
+            glyphs.push_back(glyph);
+    }
+
+    // Smallest power-of-two width that keeps the page no taller than it is wide
+    int width = 64, height = 0;
+    while ((height = Pack(glyphs, width)) > width)
+        width *= 2;
+    int pageHeight = 1;
+    while (pageHeight < height)
+        pageHeight *= 2;
+
+    SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat(0, width, pageHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!page) {
+        std::cerr << "Failed to create the page surface: " << SDL_GetError() << "\n";
+        return 1;
+    }
+    SDL_FillRect(page, nullptr, 0x00FFFFFFu);  // transparent white, so filtered edges do not darken
+    for (BakedGlyph& g : glyphs) {
+        if (!g.surface)
+            continue;
+        SDL_Rect dst = {g.x, g.y, g.ink.w, g.ink.h};
+        SDL_SetSurfaceBlendMode(g.surface, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(g.surface, &g.ink, page, &dst);
+    }
+
+    const std::string pageFile = out.filename().string() + "_0.png";
+    const std::string pagePath = (out.parent_path() / pageFile).string();
+    if (IMG_SavePNG(page, pagePath.c_str()) != 0) {
+        std::cerr << "Failed to write " << pagePath << ": " << IMG_GetError() << "\n";
+        return 1;
+    }
+
+    std::ofstream fnt(out.string() + ".fnt");
+    if (!fnt) {
+        std::cerr << "Failed to write " << out.string() << ".fnt\n";
+        return 1;
+    }
+    fnt << "info face=\"Lexend\" size=" << size << " bold=0 italic=0 charset=\"\" unicode=1 stretchH=100 smooth=1 aa=1"
+        << " padding=0,0,0,0 spacing=" << kPadding << "," << kPadding << "\n";
+    fnt << "common lineHeight=" << TTF_FontLineSkip(font) << " base=" << TTF_FontAscent(font) << " scaleW=" << width
+        << " scaleH=" << pageHeight << " pages=1 packed=0\n";
+    fnt << "page id=0 file=\"" << pageFile << "\"\n";
+    fnt << "chars count=" << glyphs.size() << "\n";
+    for (const BakedGlyph& g : glyphs) {
+        fnt << "char id=" << g.codepoint << " x=" << g.x << " y=" << g.y << " width=" << g.ink.w
+            << " height=" << g.ink.h << " xoffset=" << g.offsetX << " yoffset=" << g.offsetY
+            << " xadvance=" << g.advance << " page=0 chnl=15\n";
+    }
+
+    std::vector<std::string> kernings;
+    for (const BakedGlyph& left : glyphs) {
+        for (const BakedGlyph& right : glyphs) {
+            int amount = TTF_GetFontKerningSizeGlyphs32(font, left.codepoint, right.codepoint);
+            if (amount != 0)
+                kernings.push_back("kerning first=" + std::to_string(left.codepoint) +
+                                   " second=" + std::to_string(right.codepoint) + " amount=" + std::to_string(amount));
+        }
+    }
+    fnt << "kernings count=" << kernings.size() << "\n";
+    for (const std::string& line : kernings)
+        fnt << line << "\n";
+
+    std::cout << "Baked " << glyphs.size() << " glyphs at " << size << "px into " << width << "x" << pageHeight
+              << ", " << kernings.size() << " kerning pairs\n";
+
+    for (BakedGlyph& g : glyphs)
+        SDL_FreeSurface(g.surface);
+    SDL_FreeSurface(page);
+    TTF_CloseFont(font);
+    IMG_Quit();
+    TTF_Quit();
+    return 0;
+}
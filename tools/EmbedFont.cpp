@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Usage: EmbedFont <input.ttf> <output.h> <symbol>
+// Writes a header embedding the file as an LZ4 block (<symbol>_lz4) plus its decompressed size (<symbol>_len).
+// The library decompresses it on first use, see core/EmbeddedFont.h.
+
+static constexpr int    kMinMatch     = 4;
+static constexpr int    kHashBits     = 16;
+static constexpr size_t kWindow       = 65535;
+static constexpr int    kMaxChain     = 256;  // candidates per position; compression runs at build time only
+static constexpr size_t kLastLiterals = 5;    // LZ4 ends every block with at least this many literals
+static constexpr size_t kMatchLimit   = 12;   // and starts the last match at least this far from the end
+
+static void WriteLength(std::vector<uint8_t>& out, size_t length) {
+    for (; length >= 255; length -= 255)
+        out.push_back(255);
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+static void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount, size_t offset,
+                          size_t matchLength) {
+    const size_t match = matchLength >= kMinMatch ? matchLength - kMinMatch : 0;
+    out.push_back(static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(match, 15)));
+    if (literalCount >= 15)
+        WriteLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0)
+        return;  // last sequence: literals only
+
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (match >= 15)
+        WriteLength(out, match - 15);
+}
+
+// Greedy LZ4 block compression over hash chains
+static std::vector<uint8_t> CompressLz4(const std::vector<uint8_t>& in) {
+    const size_t n     = in.size();
+    const size_t limit = n > kMatchLimit ? n - kMatchLimit : 0;
+
+    std::vector<int64_t> head(size_t(1) << kHashBits, -1), prev(n, -1);
+
+    auto hash = [&](size_t i) {
+        uint32_t v;
+        std::memcpy(&v, &in[i], sizeof(v));
+        return (v * 2654435761u) >> (32 - kHashBits);
+    };
+    auto insert = [&](size_t i) {
+        const uint32_t h = hash(i);
+        prev[i]          = head[h];
+        head[h]          = static_cast<int64_t>(i);
+    };
+
+    std::vector<uint8_t> out;
+    size_t               anchor = 0, i = 0;
+    while (i < limit) {
+        size_t bestLength = 0, bestOffset = 0;
+        int    chain      = 0;
+        for (int64_t c = head[hash(i)]; c >= 0 && i - c <= kWindow && chain < kMaxChain; c = prev[c], ++chain) {
+            size_t length = 0;
+            while (i + length < n - kLastLiterals && in[c + length] == in[i + length])
+                ++length;
+            if (length > bestLength) {
+                bestLength = length;
+                bestOffset = i - c;
+            }
+        }
+        insert(i);
+        if (bestLength < kMinMatch) {
+            ++i;
+            continue;
+        }
+
+        WriteSequence(out, &in[anchor], i - anchor, bestOffset, bestLength);
+        for (size_t j = i + 1; j < i + bestLength && j < limit; ++j)
+            insert(j);
+        i += bestLength;
+        anchor = i;
+    }
+    WriteSequence(out, in.data() + anchor, n - anchor, 0, 0);
+    return out;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: EmbedFont <input.ttf> <output.h> <symbol>\n";
+        return 1;
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to read " << argv[1] << "\n";
+        return 1;
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::vector<uint8_t> packed = CompressLz4(data);
+
+    std::ofstream out(argv[2]);
+    if (!out) {
+        std::cerr << "Failed to write " << argv[2] << "\n";
+        return 1;
+    }
+    const std::string symbol = argv[3];
+    out << "#pragma once\n\n";
+    out << "// Generated by tools/EmbedFont.cpp, do not edit. Decompress through ugfx::DefaultFontData().\n";
+    out << "inline constexpr unsigned int  " << symbol << "_len   = " << data.size() << ";\n";
+    out << "inline constexpr unsigned char " << symbol << "_lz4[] = {";
+    char hex[8];
+    for (size_t i = 0; i < packed.size(); ++i) {
+        std::snprintf(hex, sizeof(hex), "0x%02x", packed[i]);
+        out << (i % 19 == 0 ? "\n    " : " ") << hex << (i + 1 < packed.size() ? "," : "");
+    }
+    out << "};\n";
+
+    std::cout << "Embedded " << argv[1] << ": " << data.size() << " -> " << packed.size() << " bytes\n";
+    return 0;
+}